@@ -0,0 +1,230 @@
+/**
+ * @file AutomatonCache.cpp
+ * @details Contains the definitions of the cache of parsed and compiled automata used by the interactive session.
+ */
+
+#include<sstream>
+#include<string>
+#include<utility>
+#include<vector>
+#include"AutomatonCache.h"
+#include"Simulator.h"
+
+/**
+ * @brief Constructor
+ * @details Takes the parsed NFA and indexes it.
+ * @param nfa - rvalue reference to an object of type NFA;
+ */
+CachedAutomaton::CachedAutomaton(NFA&& nfa) : nfa(std::move(nfa)), hasNFA(true), index(this->nfa), compiled(false),
+                                               hasDFA(false){
+}
+
+/**
+ * @brief Constructor
+ * @details Indexes the NFA straight from its mapped records, without copying it.
+ * @param view - reference to an object of type NFAView, it must stay valid while the entry is used;
+ */
+CachedAutomaton::CachedAutomaton(const NFAView& view) : nfa(nullptr, 0, 0, nullptr, 0, 0), view(view), hasNFA(false),
+                                                        index(view), compiled(false), hasDFA(false){
+}
+
+/**
+ * @details Returns the cache entry of NFA, loading the NFA if it isn't in the cache yet. The attached binary file is
+ * searched first - it costs a binary search in its index and, if the file is mapped, nothing else or one seek if it
+ * isn't - and the temporary file is scanned only if the binary file doesn't have the NFA.
+ * @param id - identifier of the NFA;
+ * @return the cache entry.
+ * @see BinaryCatalog::load(int id, NFA& nfa)
+ * @see NFA::readFromFile(int id)
+ */
+CachedAutomaton& AutomatonCache::entry(int id){
+    std::unordered_map<int, std::unique_ptr<CachedAutomaton> >::iterator found = entries.find(id);
+    if(found != entries.end())
+        return *found->second;
+
+    std::unique_ptr<CachedAutomaton>& created = entries[id];
+    NFAView view;
+    if(mapped.isOpen() && mapped.find(id, view)){
+        created.reset(new CachedAutomaton(view));
+        return *created;
+    }
+
+    NFA nfa;
+    if(catalogName.empty() || !catalog.load(id, nfa))
+        nfa.readFromFile(id);
+    nfa.setID(id);
+    created.reset(new CachedAutomaton(std::move(nfa)));
+    return *created;
+}
+
+/**
+ * @details Compiles the NFA of an entry to minimal DFA, or prepares LazyDFA if the DFA would have too many states.
+ * @param cached - reference to an object of type CachedAutomaton;
+ */
+void AutomatonCache::compile(CachedAutomaton& cached){
+    if(cached.compiled)
+        return;
+    cached.compiled = true;
+    cached.hasDFA = cached.dfa.compile(Simulator(cached.index));
+    if(cached.hasDFA)
+        cached.dfa.minimize();
+    else
+        cached.lazyDFA.reset(new LazyDFA(cached.index));
+}
+
+/**
+ * @details The NFA of a mapped entry is copied out of the mapping the first time it's needed.
+ * @param id - identifier of the NFA;
+ * @return the NFA with that identifier, empty NFA if there is no such NFA in the file.
+ */
+const NFA& AutomatonCache::get(int id){
+    CachedAutomaton& cached = entry(id);
+    if(!cached.hasNFA){
+        cached.nfa = cached.view.toNFA();
+        cached.nfa.setID(id);
+        cached.hasNFA = true;
+    }
+    return cached.nfa;
+}
+
+/**
+ * @param id - identifier of the NFA;
+ * @return the index of the NFA with that identifier.
+ */
+const NFAIndex& AutomatonCache::getIndex(int id){
+    return entry(id).index;
+}
+
+/**
+ * @details Compiles the NFA the first time it's called for the identifier.
+ * @param id - identifier of the NFA;
+ * @return the DFA of the NFA or nullptr if the DFA would have too many states.
+ */
+const DFA* AutomatonCache::getDFA(int id){
+    CachedAutomaton& cached = entry(id);
+    compile(cached);
+    return cached.hasDFA ? &cached.dfa : nullptr;
+}
+
+/**
+ * @brief Checks if NFA recognizes word.
+ * @details Uses the memoized DFA, or the memoized LazyDFA if the DFA is too big.
+ *
+ * @param id - identifier of the NFA;
+ * @param word - the word we are trying to recognize;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+bool AutomatonCache::recognise(int id, const char* word, size_t length){
+    CachedAutomaton& cached = entry(id);
+    compile(cached);
+    if(cached.hasDFA)
+        return cached.dfa.recognise(word, length);
+    return cached.lazyDFA->recognise(word, length);
+}
+
+/**
+ * @brief Merges all the automata of the session into one set.
+ * @details The set is built only the first time it's needed after the cache was invalidated or a file was attached
+ * or detached - then the identifiers are read from the temporary file and the attached file is added.
+ *
+ * @param file - the temporary file;
+ * @return the set of all the automata of the temporary file and of the attached file.
+ * @see NFASet
+ */
+const NFASet& AutomatonCache::getSet(std::istream& file){
+    if(set)
+        return *set;
+
+    //every line of the temporary file that starts with '<' has the identifier of a NFA
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    std::vector<const NFA*> nfas;
+    std::string line;
+    while(getline(file, line)){
+        if(!line.empty() && line[0] == '<'){
+            std::stringstream lineStream(line);
+            std::string bracket;
+            int id;
+            lineStream>>bracket>>id;
+            nfas.push_back(&get(id));
+        }
+    }
+    for(int i = 0; i < getAttachedNum(); i++)
+        nfas.push_back(&get(getAttachedID(i)));
+
+    set.reset(new NFASet(nfas));
+    return *set;
+}
+
+/**
+ * @brief Removes all the cached automata.
+ * @details Must be called whenever the temporary file changes.
+ */
+void AutomatonCache::invalidate(){
+    entries.clear();
+    set.reset();
+}
+
+/**
+ * @brief Attaches binary NFA file.
+ * @details The file is memory-mapped, or only its index is read if it can't be mapped. The file that was attached
+ * before is detached and the cached automata are removed, because the new file may have automata with the same
+ * identifiers.
+ *
+ * @param name - the name of the binary file;
+ * @return true if the file was opened and is in the supported format and false otherwise.
+ */
+bool AutomatonCache::attach(const std::string& name){
+    detach();
+    if(!mapped.open(name) && !catalog.open(name)){
+        catalog.close();
+        return false;
+    }
+    catalogName = name;
+    return true;
+}
+
+/**
+ * @brief Detaches the binary NFA file.
+ * @details The automata that were loaded from it and the merged set are removed from the cache before the file is
+ * unmapped.
+ */
+void AutomatonCache::detach(){
+    entries.clear();
+    set.reset();
+    mapped.close();
+    catalog.close();
+    catalogName.clear();
+}
+
+/**
+ * @return true if a binary NFA file is attached and false otherwise.
+ */
+bool AutomatonCache::isAttached() const{
+    return !catalogName.empty();
+}
+
+/**
+ * @return the name of the attached binary NFA file, empty if no file is attached.
+ */
+const std::string& AutomatonCache::getAttachedName() const{
+    return catalogName;
+}
+
+/**
+ * @return the number of automata in the attached binary NFA file.
+ */
+int AutomatonCache::getAttachedNum() const{
+    if(mapped.isOpen())
+        return mapped.getAutomataNum();
+    return isAttached() ? catalog.getAutomataNum() : 0;
+}
+
+/**
+ * @param position - position in the index of the attached file, 0..getAttachedNum() - 1;
+ * @return the identifier of the automation at that position.
+ */
+int AutomatonCache::getAttachedID(int position) const{
+    return mapped.isOpen() ? mapped.getID(position) : catalog.getID(position);
+}
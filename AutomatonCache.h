@@ -0,0 +1,82 @@
+/**
+ * \headerfile AutomatonCache.h
+ * @details Contains the declaration of the cache of parsed and compiled automata used by the interactive session.
+ */
+
+#ifndef NFA_AUTOMATONCACHE_H
+#define NFA_AUTOMATONCACHE_H
+
+#include<cstddef>
+#include<istream>
+#include<memory>
+#include<string>
+#include<unordered_map>
+#include"BinaryCatalog.h"
+#include"DFA.h"
+#include"LazyDFA.h"
+#include"MappedCatalog.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+#include"NFASet.h"
+
+/**
+ * @struct CachedAutomaton
+ * @brief Everything the session knows about one NFA from the file.
+ * @details The NFA and its index are built when the entry is created; the DFA is compiled the first time it's needed.
+ * If the DFA would be too big, a LazyDFA is used instead. The entries of a mapped binary file are indexed straight
+ * from the mapping and their NFA is copied out of it only if a command needs the NFA itself - recognition uses only
+ * the index.
+ */
+struct CachedAutomaton{
+    NFA nfa;/**< - the parsed NFA, valid if hasNFA is true;*/
+    NFAView view;/**< - the mapped records of the NFA, if it comes from a mapped binary file;*/
+    bool hasNFA;/**< - shows if nfa holds the NFA;*/
+    NFAIndex index;/**< - the index of the NFA;*/
+    bool compiled;/**< - shows if compilation has already been tried;*/
+    bool hasDFA;/**< - shows if the NFA was compiled to DFA;*/
+    DFA dfa;/**< - the compiled and minimized DFA, valid if hasDFA is true;*/
+    std::unique_ptr<LazyDFA> lazyDFA;/**< - used instead of the DFA if the DFA is too big;*/
+
+    explicit CachedAutomaton(NFA&& nfa);
+    explicit CachedAutomaton(const NFAView& view);
+};
+
+/**
+ * @class AutomatonCache
+ * @brief Session-level cache of the automata read from the temporary file.
+ * @details Every NFA is parsed only once and every compilation is done only once, no matter how many commands use it.
+ * The cache must be invalidated whenever the file changes. A binary NFA file can be attached to the cache - then its
+ * automata are loaded straight from their records, found through the index of the file, and the temporary file is
+ * read only for the identifiers the binary file doesn't have. The attached file is memory-mapped, so attaching costs
+ * the same for any size of the file and processes that attach the same file share its pages; if it can't be mapped
+ * it's read through BinaryCatalog. The merged set of all the automata is kept as well, so matching a word against all
+ * of them doesn't rebuild it; it's removed with the cached automata whenever the file or the attached file changes.
+ */
+class AutomatonCache{
+private:
+    std::unordered_map<int, std::unique_ptr<CachedAutomaton> > entries;/**< - the cached automata by ID;*/
+    MappedCatalog mapped;/**< - the attached binary NFA file, if it could be mapped;*/
+    BinaryCatalog catalog;/**< - the attached binary NFA file, if it couldn't be mapped;*/
+    std::string catalogName;/**< - the name of the attached binary NFA file, empty if no file is attached;*/
+    std::unique_ptr<NFASet> set;/**< - all the automata of the session merged, built the first time it's needed;*/
+
+    CachedAutomaton& entry(int);
+    void compile(CachedAutomaton&);
+
+public:
+    const NFA& get(int);
+    const NFAIndex& getIndex(int);
+    const DFA* getDFA(int);
+    bool recognise(int, const char*, size_t);
+    const NFASet& getSet(std::istream&);
+    void invalidate();
+
+    bool attach(const std::string&);
+    void detach();
+    bool isAttached() const;
+    const std::string& getAttachedName() const;
+    int getAttachedNum() const;
+    int getAttachedID(int) const;
+};
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @file Batch.cpp
+ * @details Contains the definitions of batch word recognition over many worker threads.
+ */
+
+#include<fstream>
+#include<sstream>
+#include<thread>
+#include"Batch.h"
+#include"DFA.h"
+#include"Simulator.h"
+
+/**
+ * @brief Reads newline-delimited word file.
+ * @param name - the name of the file;
+ * @return true if the file was read and false otherwise.
+ */
+bool WordList::readFromFile(const std::string& name){
+    std::ifstream file(name, std::ios::in | std::ios::binary);
+    if(!file)
+        return false;
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    buffer = content.str();
+    split();
+    return true;
+}
+
+/**
+ * @details Finds the words in the buffer. The last line counts only if it's not empty.
+ */
+void WordList::split(){
+    offsets.clear();
+    lengths.clear();
+
+    size_t begin = 0;
+    while(begin < buffer.size()){
+        size_t end = buffer.find('\n', begin);
+        if(end == std::string::npos)
+            end = buffer.size();
+        size_t length = end - begin;
+        if(length > 0 && buffer[end - 1] == '\r')
+            length--;
+        offsets.push_back(begin);
+        lengths.push_back(length);
+        begin = end + 1;
+    }
+}
+
+/**
+ * @return the number of words.
+ */
+size_t WordList::size() const{
+    return offsets.size();
+}
+
+/**
+ * @brief Constructor
+ * @details Creates result of empty batch.
+ */
+BatchResult::BatchResult() : wordsNum(0), acceptedNum(0){
+}
+
+/**
+ * @param word - position of the word in the batch;
+ * @return true if the word was recognized and false otherwise.
+ */
+bool BatchResult::isAccepted(size_t word) const{
+    return (accepted[word >> 6] >> (word & 63)) & 1;
+}
+
+/**
+ * @brief Recognizes the words of one block one after another.
+ *
+ * @param automation - the automation, its recognise(const char*, size_t) must be const and thread-safe;
+ * @param words - the words of the batch;
+ * @param first - the first word of the block;
+ * @param last - the position after the last word of the block, at most first + 64;
+ * @return bitmap of the recognized words of the block.
+ */
+template<typename Automation>
+static uint64_t recogniseBlock(const Automation& automation, const WordList& words, size_t first, size_t last){
+    uint64_t bits = 0;
+    for(size_t i = first; i < last; i++){
+        if(automation.recognise(words.buffer.data() + words.offsets[i], words.lengths[i]))
+            bits |= uint64_t(1) << (i - first);
+    }
+    return bits;
+}
+
+/**
+ * @brief Recognizes the words of one block with interleaved DFA walks.
+ * @details Recognizing one word is a chain of table loads where every load needs the result of the previous one, so
+ * the processor waits for memory on every symbol. Here up to LANES words are walked together - the loads of the
+ * different lanes don't depend on each other and are in flight at the same time. The lanes advance in lockstep for as
+ * many symbols as the shortest of them has left; then the finished lanes take the next words of the block.
+ *
+ * @param dfa - the DFA;
+ * @param words - the words of the batch;
+ * @param first - the first word of the block;
+ * @param last - the position after the last word of the block, at most first + 64;
+ * @return bitmap of the recognized words of the block.
+ */
+static uint64_t recogniseBlock(const DFA& dfa, const WordList& words, size_t first, size_t last){
+    const int LANES = 8;
+    const uint32_t* table = dfa.getTable();
+    const uint8_t* classOf = dfa.getClasses().classOf;
+    uint32_t alphabetSize = dfa.getAlphabetSize();
+
+    const unsigned char* position[LANES];
+    size_t left[LANES];
+    size_t word[LANES];
+    uint32_t state[LANES];
+
+    uint64_t bits = 0;
+    size_t nextWord = first;
+    int active = 0;
+    while(active < LANES && nextWord < last){
+        position[active] = (const unsigned char*)words.buffer.data() + words.offsets[nextWord];
+        left[active] = words.lengths[nextWord];
+        word[active] = nextWord++;
+        state[active] = dfa.getStart();
+        active++;
+    }
+
+    while(active > 0){
+        size_t steps = left[0];
+        for(int lane = 1; lane < active; lane++){
+            if(left[lane] < steps)
+                steps = left[lane];
+        }
+
+        //with all the lanes busy the lane loop has constant length and is unrolled
+        if(active == LANES){
+            for(size_t i = 0; i < steps; i++){
+                for(int lane = 0; lane < LANES; lane++)
+                    state[lane] = table[state[lane] * alphabetSize + classOf[position[lane][i]]];
+            }
+        }else{
+            for(size_t i = 0; i < steps; i++){
+                for(int lane = 0; lane < active; lane++)
+                    state[lane] = table[state[lane] * alphabetSize + classOf[position[lane][i]]];
+            }
+        }
+
+        for(int lane = 0; lane < active; lane++){
+            position[lane] += steps;
+            left[lane] -= steps;
+        }
+
+        //the finished lanes take the next words or are removed by moving the last lane in their place
+        int lane = 0;
+        while(lane < active){
+            if(left[lane] > 0){
+                lane++;
+                continue;
+            }
+            if(dfa.isFinal(state[lane]))
+                bits |= uint64_t(1) << (word[lane] - first);
+
+            if(nextWord < last){
+                position[lane] = (const unsigned char*)words.buffer.data() + words.offsets[nextWord];
+                left[lane] = words.lengths[nextWord];
+                word[lane] = nextWord++;
+                state[lane] = dfa.getStart();
+            }else{
+                active--;
+                position[lane] = position[active];
+                left[lane] = left[active];
+                word[lane] = word[active];
+                state[lane] = state[active];
+            }
+        }
+    }
+    return bits;
+}
+
+/**
+ * @brief Recognizes all the words of a batch with a shared automation.
+ * @details The words are split into one contiguous chunk per worker. Chunks start at multiples of 64 words, so every
+ * worker writes its own words of the bitmap and the workers never share anything but the read-only automation.
+ *
+ * @param automation - the automation, its recognise(const char*, size_t) must be const and thread-safe;
+ * @param words - the words we check;
+ * @param threads - number of workers, 0 means one per hardware thread;
+ * @return the result of the batch.
+ */
+template<typename Automation>
+static BatchResult run(const Automation& automation, const WordList& words, unsigned threads){
+    BatchResult result;
+    result.wordsNum = words.size();
+    size_t blocks = (result.wordsNum + 63) / 64;
+    result.accepted.assign(blocks, 0);
+
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+    if(threads > blocks)
+        threads = unsigned(blocks);
+
+    std::vector<size_t> counts(threads, 0);
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; t++){
+        workers.push_back(std::thread([&, t](){
+            size_t firstBlock = blocks * t / threads, lastBlock = blocks * (t + 1) / threads;
+            size_t count = 0;
+            for(size_t block = firstBlock; block < lastBlock; block++){
+                size_t first = block * 64, last = first + 64 < result.wordsNum ? first + 64 : result.wordsNum;
+                uint64_t bits = recogniseBlock(automation, words, first, last);
+                result.accepted[block] = bits;
+                count += __builtin_popcountll(bits);
+            }
+            counts[t] = count;
+        }));
+    }
+    for(size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    for(size_t t = 0; t < counts.size(); t++)
+        result.acceptedNum += counts[t];
+    return result;
+}
+
+/**
+ * @brief Recognizes all the words of a batch with compiled DFA.
+ *
+ * @param dfa - the DFA shared by all the workers;
+ * @param words - the words we check;
+ * @param threads - number of workers, 0 means one per hardware thread;
+ * @return the result of the batch.
+ */
+BatchResult recognizeBatch(const DFA& dfa, const WordList& words, unsigned threads){
+    return run(dfa, words, threads);
+}
+
+/**
+ * @brief Recognizes all the words of a batch with NFA simulation.
+ * @details Used when the NFA can't be compiled to DFA.
+ *
+ * @param simulator - the simulator shared by all the workers;
+ * @param words - the words we check;
+ * @param threads - number of workers, 0 means one per hardware thread;
+ * @return the result of the batch.
+ */
+BatchResult recognizeBatch(const Simulator& simulator, const WordList& words, unsigned threads){
+    return run(simulator, words, threads);
+}
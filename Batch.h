@@ -0,0 +1,49 @@
+/**
+ * \headerfile Batch.h
+ * @details Contains the declarations of batch word recognition over many worker threads.
+ */
+
+#ifndef NFA_BATCH_H
+#define NFA_BATCH_H
+
+#include<cstddef>
+#include<cstdint>
+#include<string>
+#include<vector>
+
+class DFA;
+class Simulator;
+
+/**
+ * @struct WordList
+ * @brief Newline-delimited words stored in one buffer.
+ * @details Word i is buffer[offsets[i]..offsets[i] + lengths[i]). A '\r' before the newline isn't part of the word.
+ */
+struct WordList{
+    std::string buffer;/**< - the content of the word file;*/
+    std::vector<size_t> offsets;/**< - where every word starts in the buffer;*/
+    std::vector<size_t> lengths;/**< - the length of every word;*/
+
+    bool readFromFile(const std::string&);
+    void split();
+    size_t size() const;
+};
+
+/**
+ * @struct BatchResult
+ * @brief Result of batch recognition.
+ * @details Bit i of the bitmap is 1 if word i was recognized.
+ */
+struct BatchResult{
+    std::vector<uint64_t> accepted;/**< - bitmap of the recognized words;*/
+    size_t wordsNum;/**< - number of words checked;*/
+    size_t acceptedNum;/**< - number of words recognized;*/
+
+    BatchResult();
+    bool isAccepted(size_t) const;
+};
+
+BatchResult recognizeBatch(const DFA&, const WordList&, unsigned = 0);
+BatchResult recognizeBatch(const Simulator&, const WordList&, unsigned = 0);
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file BinaryCatalog.cpp
+ * @details Contains the definitions of the binary NFA file format reader, writer and converters.
+ */
+
+#include<algorithm>
+#include<sstream>
+#include"BinaryCatalog.h"
+#include"NFA.h"
+
+const uint32_t BinaryCatalog::MAGIC;
+const uint32_t BinaryCatalog::VERSION;
+
+/**
+ * @details Compares index entries by ID, used to sort and search the index.
+ */
+static bool lessByID(const BinaryIndexEntry& one, const BinaryIndexEntry& two){
+    return one.id < two.id;
+}
+
+/**
+ * @brief Constructor
+ * @details Creates catalog with no file opened.
+ */
+BinaryCatalog::BinaryCatalog() : fileSize(0){
+}
+
+/**
+ * @brief Opens binary NFA file and reads its index.
+ *
+ * @param name - the name of the file;
+ * @return true if the file was opened and is in the supported format and false otherwise.
+ */
+bool BinaryCatalog::open(const std::string& name){
+    close();
+
+    file.open(name, std::ios::in | std::ios::binary);
+    if(!file)
+        return false;
+    file.seekg(0, std::ios::end);
+    fileSize = uint64_t(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    BinaryFileHeader header;
+    if(!file.read((char*)&header, sizeof(header)) || header.magic != MAGIC || header.version != VERSION)
+        return false;
+
+    //the index must fit in the file
+    if(sizeof(BinaryFileHeader) + uint64_t(header.automataNum) * sizeof(BinaryIndexEntry) > fileSize)
+        return false;
+
+    index.resize(header.automataNum);
+    if(header.automataNum > 0 && !file.read((char*)index.data(), header.automataNum * sizeof(BinaryIndexEntry))){
+        index.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Closes the opened file.
+ */
+void BinaryCatalog::close(){
+    file.close();
+    file.clear();
+    index.clear();
+    fileSize = 0;
+}
+
+/**
+ * @return the number of automata in the opened file.
+ */
+int BinaryCatalog::getAutomataNum() const{
+    return int(index.size());
+}
+
+/**
+ * @param position - position in the index, 0..getAutomataNum() - 1;
+ * @return the identifier of the automation at that position, the identifiers are in increasing order.
+ */
+int BinaryCatalog::getID(int position) const{
+    return index[position].id;
+}
+
+/**
+ * @param id - identifier of the NFA we are searching;
+ * @return the index entry of the NFA or nullptr if there is no such NFA.
+ */
+const BinaryIndexEntry* BinaryCatalog::find(int id) const{
+    BinaryIndexEntry key;
+    key.id = id;
+    std::vector<BinaryIndexEntry>::const_iterator it = std::lower_bound(index.begin(), index.end(), key, lessByID);
+    if(it == index.end() || it->id != id)
+        return nullptr;
+    return &*it;
+}
+
+/**
+ * @brief Loads NFA from the opened file.
+ * @details Seeks straight to the record of the NFA and reads its states and transitions.
+ *
+ * @param id - identifier of the NFA we are searching;
+ * @param nfa - the NFA the states and transitions are added to;
+ * @return true if the NFA was found and read and false otherwise.
+ */
+bool BinaryCatalog::load(int id, NFA& nfa){
+    const BinaryIndexEntry* entry = find(id);
+    if(entry == nullptr || entry->offset > fileSize || fileSize - entry->offset < sizeof(BinaryRecordHeader))
+        return false;
+
+    file.clear();
+    file.seekg(entry->offset, std::ios::beg);
+
+    BinaryRecordHeader header;
+    if(!file.read((char*)&header, sizeof(header)))
+        return false;
+
+    //the states and transitions must fit in the rest of the file
+    if(uint64_t(header.statesNum) * sizeof(BinaryState) + uint64_t(header.transitionsNum) * sizeof(BinaryTransition) >
+       fileSize - entry->offset - sizeof(BinaryRecordHeader))
+        return false;
+
+    std::vector<BinaryState> states(header.statesNum);
+    std::vector<BinaryTransition> transitions(header.transitionsNum);
+    if(header.statesNum > 0 && !file.read((char*)states.data(), header.statesNum * sizeof(BinaryState)))
+        return false;
+    if(header.transitionsNum > 0 && !file.read((char*)transitions.data(), header.transitionsNum * sizeof(BinaryTransition)))
+        return false;
+
+    nfa.setID(header.id);
+    nfa.reserve(nfa.getCurrentStatesNum() + header.statesNum,
+                nfa.getCurrentTransitionsNum() + header.transitionsNum);
+    nfa.setInitialState(State(header.initialState, header.initialFinal != 0));
+    for(uint32_t i = 0; i < header.statesNum; i++)
+        nfa.addState(State(states[i].name, states[i].isFinal != 0));
+    for(uint32_t i = 0; i < header.transitionsNum; i++)
+        nfa.addTransition(Transition(transitions[i].from, transitions[i].to, (char)transitions[i].literal));
+    return true;
+}
+
+/**
+ * @brief Writes automata to a binary NFA file.
+ * @details The file is overwritten. Every NFA is stored under its identifier.
+ *
+ * @param name - the name of the file;
+ * @param nfas - the automata we write;
+ * @return true if the file was written and false otherwise.
+ */
+bool BinaryCatalog::write(const std::string& name, const std::vector<NFA>& nfas){
+    std::ofstream file(name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file)
+        return false;
+
+    BinaryFileHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.automataNum = uint32_t(nfas.size());
+    header.reserved = 0;
+
+    //the records follow the index, every record starts at offset multiple of 8
+    std::vector<BinaryIndexEntry> entries(nfas.size());
+    uint64_t offset = sizeof(BinaryFileHeader) + nfas.size() * sizeof(BinaryIndexEntry);
+    for(size_t i = 0; i < nfas.size(); i++){
+        entries[i].id = nfas[i].getID();
+        entries[i].reserved = 0;
+        entries[i].offset = offset;
+        offset += sizeof(BinaryRecordHeader) + nfas[i].getCurrentStatesNum() * sizeof(BinaryState) +
+                  nfas[i].getCurrentTransitionsNum() * sizeof(BinaryTransition);
+        offset = (offset + 7) / 8 * 8;
+    }
+
+    std::vector<BinaryIndexEntry> sorted(entries);
+    std::stable_sort(sorted.begin(), sorted.end(), lessByID);
+    file.write((const char*)&header, sizeof(header));
+    if(!sorted.empty())
+        file.write((const char*)sorted.data(), sorted.size() * sizeof(BinaryIndexEntry));
+
+    const char padding[8] = {0};
+    for(size_t i = 0; i < nfas.size(); i++){
+        const NFA& nfa = nfas[i];
+
+        BinaryRecordHeader record;
+        record.id = nfa.getID();
+        record.initialState = nfa.getInitialState().name;
+        record.initialFinal = nfa.getInitialState().isFinal ? 1 : 0;
+        record.statesNum = uint32_t(nfa.getCurrentStatesNum());
+        record.transitionsNum = uint32_t(nfa.getCurrentTransitionsNum());
+        record.reserved = 0;
+        file.write((const char*)&record, sizeof(record));
+
+        std::vector<BinaryState> states(record.statesNum);
+        for(uint32_t j = 0; j < record.statesNum; j++){
+            states[j].name = nfa.getStates()[j].name;
+            states[j].isFinal = nfa.getStates()[j].isFinal ? 1 : 0;
+        }
+        std::vector<BinaryTransition> transitions(record.transitionsNum);
+        for(uint32_t j = 0; j < record.transitionsNum; j++){
+            transitions[j].from = nfa.getTransitions()[j].from;
+            transitions[j].to = nfa.getTransitions()[j].to;
+            transitions[j].literal = (unsigned char)nfa.getTransitions()[j].literal;
+        }
+        if(!states.empty())
+            file.write((const char*)states.data(), states.size() * sizeof(BinaryState));
+        if(!transitions.empty())
+            file.write((const char*)transitions.data(), transitions.size() * sizeof(BinaryTransition));
+
+        uint64_t end = uint64_t(file.tellp());
+        file.write(padding, (8 - end % 8) % 8);
+    }
+    return bool(file);
+}
+
+/**
+ * @brief Converts text NFA file to binary NFA file.
+ * @details Reads all the automata of the text file in one pass.
+ *
+ * @param textName - the name of the text file;
+ * @param binaryName - the name of the binary file, it's overwritten;
+ * @return true if the conversion succeeded and false otherwise.
+ * @see NFA::readFromStream(std::istream& file)
+ */
+bool BinaryCatalog::convertTextToBinary(const std::string& textName, const std::string& binaryName){
+    std::ifstream file(textName, std::ios::in);
+    if(!file)
+        return false;
+
+    std::vector<NFA> nfas;
+    std::string line;
+    while(getline(file, line)){
+        //checks if the first sign of the line is '<' so it means it is an identifier
+        if(!line.empty() && line[0] == '<'){
+            std::stringstream streamFile(line);
+            int found;
+            std::string wordHelp;
+            streamFile >> wordHelp >> found;
+
+            nfas.push_back(NFA());
+            nfas.back().setID(found);
+            nfas.back().readFromStream(file);
+        }
+    }
+    return write(binaryName, nfas);
+}
+
+/**
+ * @brief Converts binary NFA file to text NFA file.
+ *
+ * @param binaryName - the name of the binary file;
+ * @param textName - the name of the text file, the automata are added at its end;
+ * @return true if the conversion succeeded and false otherwise.
+ * @see NFA::writeToFile(const char* name)
+ */
+bool BinaryCatalog::convertBinaryToText(const std::string& binaryName, const std::string& textName){
+    BinaryCatalog catalog;
+    if(!catalog.open(binaryName))
+        return false;
+
+    for(int i = 0; i < catalog.getAutomataNum(); i++){
+        NFA nfa;
+        if(!catalog.load(catalog.getID(i), nfa))
+            return false;
+        nfa.writeToFile(textName.c_str());
+    }
+    return true;
+}
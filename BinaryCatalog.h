@@ -0,0 +1,104 @@
+/**
+ * \headerfile BinaryCatalog.h
+ * @details Contains the declarations of the binary NFA file format and the catalog that reads it.
+ */
+
+#ifndef NFA_BINARYCATALOG_H
+#define NFA_BINARYCATALOG_H
+
+#include<cstdint>
+#include<fstream>
+#include<string>
+#include<vector>
+
+class NFA;
+
+/**
+ * @struct BinaryFileHeader
+ * @brief The first bytes of a binary NFA file.
+ * @details Followed by automataNum index entries sorted by ID and then by the automata records. All the numbers are
+ * stored in the byte order of the machine that wrote the file - the magic number shows if it's the same.
+ */
+struct BinaryFileHeader{
+    uint32_t magic;/**< - always BinaryCatalog::MAGIC;*/
+    uint32_t version;/**< - the version of the format;*/
+    uint32_t automataNum;/**< - number of automata in the file;*/
+    uint32_t reserved;/**< - always 0;*/
+};
+
+/**
+ * @struct BinaryIndexEntry
+ * @brief Maps the ID of an automation to the offset of its record.
+ */
+struct BinaryIndexEntry{
+    int32_t id;/**< - the identifier of the NFA;*/
+    uint32_t reserved;/**< - always 0;*/
+    uint64_t offset;/**< - offset of the record from the beginning of the file, multiple of 8;*/
+};
+
+/**
+ * @struct BinaryRecordHeader
+ * @brief The first bytes of an automation record.
+ * @details Followed by statesNum BinaryState and transitionsNum BinaryTransition records.
+ */
+struct BinaryRecordHeader{
+    int32_t id;/**< - the identifier of the NFA;*/
+    int32_t initialState;/**< - the name of the initial state;*/
+    uint32_t initialFinal;/**< - 1 if the initial state is final;*/
+    uint32_t statesNum;/**< - number of states;*/
+    uint32_t transitionsNum;/**< - number of transitions;*/
+    uint32_t reserved;/**< - always 0;*/
+};
+
+/**
+ * @struct BinaryState
+ * @brief Fixed-width state record.
+ */
+struct BinaryState{
+    int32_t name;/**< - the name of the state;*/
+    int32_t isFinal;/**< - 1 if the state is final;*/
+};
+
+/**
+ * @struct BinaryTransition
+ * @brief Fixed-width transition record.
+ */
+struct BinaryTransition{
+    int32_t from;/**< - the from-state name;*/
+    int32_t to;/**< - the to-state name;*/
+    int32_t literal;/**< - the literal, as unsigned char;*/
+};
+
+/**
+ * @class BinaryCatalog
+ * @brief Reader of binary NFA files.
+ * @details The index is read once, when the file is opened. Loading an automation is then a binary search in the
+ * index and a single seek to its record, no matter how many automata the file has. Nothing is allocated for a count
+ * read from the file before it's checked that the records it describes fit in the file, so a truncated or corrupt
+ * file is rejected instead of making huge allocations.
+ */
+class BinaryCatalog{
+private:
+    std::ifstream file;/**< - the opened binary file;*/
+    std::vector<BinaryIndexEntry> index;/**< - the index of the file, sorted by ID;*/
+    uint64_t fileSize;/**< - size of the opened file in bytes, the counts read from the file are checked against it;*/
+
+public:
+    static const uint32_t MAGIC = 0x4246414E;/**< - "NAFB" read as little-endian number;*/
+    static const uint32_t VERSION = 1;/**< - the version of the format this reader supports;*/
+
+    BinaryCatalog();
+
+    bool open(const std::string&);
+    void close();
+    int getAutomataNum() const;
+    int getID(int) const;
+    const BinaryIndexEntry* find(int) const;
+    bool load(int, NFA&);
+
+    static bool write(const std::string&, const std::vector<NFA>&);
+    static bool convertTextToBinary(const std::string&, const std::string&);
+    static bool convertBinaryToText(const std::string&, const std::string&);
+};
+
+#endif
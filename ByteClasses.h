@@ -0,0 +1,56 @@
+/**
+ * \headerfile ByteClasses.h
+ * @details Contains the declaration of the byte equivalence classes used to compress DFA tables.
+ */
+
+#ifndef NFA_BYTECLASSES_H
+#define NFA_BYTECLASSES_H
+
+#include<cstdint>
+
+/**
+ * @struct ByteClasses
+ * @brief Partition of the 256 byte values into classes of bytes that behave the same on every transition.
+ * @details Two bytes are in the same class if they are the literal of exactly the same (from, to) pairs of the NFA,
+ * so every set of NFA states goes to the same set on both of them. The bytes that aren't literals of the NFA have no
+ * pairs and share one class. A range such as [a-z] between the same states is one class, so DFA rows indexed by class
+ * have an entry for every distinct set of pairs instead of 256.
+ * @see Simulator::getClasses() const
+ */
+struct ByteClasses{
+    uint8_t classOf[256];/**< - classOf[b] is the class of byte b;*/
+    uint8_t representatives[256];/**< - representatives[c] is a byte of class c;*/
+    uint32_t count;/**< - number of classes, 1..256;*/
+
+    /**
+     * @brief Default constructor
+     * @details Creates single class with all the bytes.
+     */
+    ByteClasses(){
+        for(int b = 0; b < 256; b++){
+            classOf[b] = 0;
+            representatives[b] = 0;
+        }
+        count = 1;
+    }
+
+    /**
+     * @details Numbers the classes in the order of their smallest byte, so class 0 is the class of byte 0 and the
+     * representative of every class is its smallest byte.
+     * @param same - same[b] is the smallest byte that behaves the same as b, same[b] <= b;
+     */
+    void build(const uint8_t* same){
+        count = 0;
+        for(int b = 0; b < 256; b++){
+            if(same[b] == b){
+                classOf[b] = uint8_t(count);
+                representatives[count] = uint8_t(b);
+                count++;
+            }else{
+                classOf[b] = classOf[same[b]];
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @file DFA.cpp
+ * @details Contains the definitions of the compiled DFA and the subset construction that builds it.
+ */
+
+#include<unordered_map>
+#include"DFA.h"
+#include"NFA.h"
+#include"Simulator.h"
+#include"StateSet.h"
+
+const uint32_t DFA::DEAD;
+const uint32_t DFA::DEFAULT_MAX_STATES;
+
+/**
+ * @brief Constructor
+ * @details Creates DFA which has only the dead state, so it recognizes no words.
+ */
+DFA::DFA(){
+    reset(ByteClasses());
+}
+
+/**
+ * @details Removes all the states of the DFA and leaves only the dead state.
+ * @param classes - the byte classes, every row of the table has one entry for every class;
+ */
+void DFA::reset(const ByteClasses& classes){
+    this->classes = classes;
+    alphabetSize = classes.count;
+    statesNum = 0;
+    start = DEAD;
+    table.clear();
+    finals.clear();
+    addState(false);
+}
+
+/**
+ * @details Adds new state to the DFA. All the transitions of the new state lead to the dead state.
+ * @param isFinal - shows if the new state is final;
+ * @return the new state.
+ */
+uint32_t DFA::addState(bool isFinal){
+    table.resize(table.size() + alphabetSize, DEAD);
+    finals.push_back(isFinal ? 1 : 0);
+    return statesNum++;
+}
+
+/**
+ * @param from - the from-state;
+ * @param byteClass - the class of the bytes of the transition;
+ * @param to - the to-state;
+ */
+void DFA::setTransition(uint32_t from, uint32_t byteClass, uint32_t to){
+    table[from * alphabetSize + byteClass] = to;
+}
+
+/**
+ * @param state - the new initial state of the DFA;
+ */
+void DFA::setStart(uint32_t state){
+    start = state;
+}
+
+/**
+ * @return the number of states of the DFA, including the dead state.
+ */
+uint32_t DFA::getStatesNum() const{
+    return statesNum;
+}
+
+/**
+ * @return the number of entries in every row of the transition table.
+ */
+uint32_t DFA::getAlphabetSize() const{
+    return alphabetSize;
+}
+
+/**
+ * @return the byte classes that map input bytes to table columns.
+ */
+const ByteClasses& DFA::getClasses() const{
+    return classes;
+}
+
+/**
+ * @return the initial state of the DFA.
+ */
+uint32_t DFA::getStart() const{
+    return start;
+}
+
+/**
+ * @return the transition table of the DFA, getStatesNum() rows of getAlphabetSize() entries.
+ */
+const uint32_t* DFA::getTable() const{
+    return table.data();
+}
+
+/**
+ * @brief Checks if the DFA recognizes word.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the DFA recognizes the word and false otherwise.
+ */
+bool DFA::recognise(const char* word, size_t length) const{
+    const uint32_t* rows = table.data();
+    const uint8_t* classOf = classes.classOf;
+    uint32_t state = start;
+    for(size_t i = 0; i < length; i++)
+        state = rows[state * alphabetSize + classOf[(unsigned char)word[i]]];
+    return finals[state] != 0;
+}
+
+/**
+ * @brief Compiles the NFA of a simulator to this DFA.
+ * @details Subset construction over the ε-closures of the NFA states. Every DFA state is a set of NFA states; the sets
+ * are numbered in the order they are reached. The table columns are the byte classes of the NFA, so only one byte of
+ * every class is tried. The unanchored DFA recognizes the words that have a suffix in the language of the NFA - every
+ * set gets the ε-closure of the initial state added, as if the NFA could start again at every position.
+ *
+ * @param simulator - the simulator of the NFA;
+ * @param maxStates - the maximum number of DFA states we allow, including the dead state;
+ * @param unanchored - true if the DFA should be unanchored, false by default;
+ * @return true if the DFA was built and false if it would have more than maxStates states. If false is returned the DFA
+ * recognizes no words.
+ */
+bool DFA::compile(const Simulator& simulator, uint32_t maxStates, bool unanchored){
+    int statesNum = simulator.getStatesNum();
+
+    ByteClasses symbolClasses = simulator.getClasses();
+
+    reset(symbolClasses);
+    std::unordered_map<StateSet, uint32_t, StateSetHash> ids;
+    std::vector<StateSet> sets;
+
+    //the empty set is the dead state
+    StateSet set(statesNum);
+    ids[set] = DFA::DEAD;
+    sets.push_back(set);
+
+    //the ε-closure of the initial state is never empty, so the initial state is always state 1
+    simulator.startSet(set);
+    StateSet startSet(set);
+    if(maxStates < 2){
+        reset(symbolClasses);
+        return false;
+    }
+    setStart(addState(simulator.isAccepting(set)));
+    ids[set] = getStart();
+    sets.push_back(set);
+
+    //every state gets its row filled exactly once, in the order of creation
+    StateSet next(statesNum);
+    for(uint32_t current = 1; current < sets.size(); current++){
+        for(uint32_t byteClass = 0; byteClass < symbolClasses.count; byteClass++){
+            unsigned char symbol = symbolClasses.representatives[byteClass];
+            if(!simulator.usesSymbol(symbol) && !unanchored)
+                continue;
+
+            simulator.step(sets[current], symbol, next);
+            if(unanchored)
+                next.unite(startSet);
+            std::unordered_map<StateSet, uint32_t, StateSetHash>::iterator found = ids.find(next);
+            uint32_t to;
+            if(found != ids.end()){
+                to = found->second;
+            }else{
+                if(getStatesNum() >= maxStates){
+                    reset(symbolClasses);
+                    return false;
+                }
+                to = addState(simulator.isAccepting(next));
+                ids[next] = to;
+                sets.push_back(next);
+            }
+            setTransition(current, byteClass, to);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compiles the NFA to DFA.
+ *
+ * @param result - the compiled DFA;
+ * @param maxStates - the maximum number of DFA states we allow, including the dead state;
+ * @param unanchored - true if the DFA should be unanchored, false by default;
+ * @return true if the DFA was built and false if it would have more than maxStates states.
+ * @see DFA::compile(const Simulator& simulator, uint32_t maxStates, bool unanchored)
+ */
+bool NFA::compileToDFA(DFA& result, uint32_t maxStates, bool unanchored) const{
+    return result.compile(Simulator(*this), maxStates, unanchored);
+}
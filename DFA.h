@@ -0,0 +1,82 @@
+/**
+ * \headerfile DFA.h
+ * @details Contains the declaration of the compiled DFA used for fast word recognition.
+ */
+
+#ifndef NFA_DFA_H
+#define NFA_DFA_H
+
+#include<cstddef>
+#include<cstdint>
+#include<vector>
+#include"ByteClasses.h"
+
+class Simulator;
+
+/**
+ * @struct MinimizationStats
+ * @brief Shows how much minimization shrank a DFA.
+ */
+struct MinimizationStats{
+    uint32_t statesBefore;/**< - number of states before minimization, including the dead state;*/
+    uint32_t statesAfter;/**< - number of states after minimization, including the dead state;*/
+};
+
+/**
+ * @class DFA
+ * @brief Deterministic finite automation stored as a flat transition table.
+ * @details The table has one row for every DFA state with one entry for every byte class, so recognition is one
+ * class lookup and one table lookup per input byte. State 0 is always the dead state - it's not final and all its
+ * transitions lead back to it.
+ * @see ByteClasses
+ * @see NFA::compileToDFA(DFA& result, uint32_t maxStates) const
+ */
+class DFA{
+private:
+    uint32_t statesNum;/**< - number of DFA states, including the dead state;*/
+    uint32_t alphabetSize;/**< - number of entries in every row of the table, the number of byte classes;*/
+    ByteClasses classes;/**< - maps every byte to its column of the table;*/
+    uint32_t start;/**< - the initial state;*/
+    std::vector<uint32_t> table;/**< - table[state * alphabetSize + class] is the next state;*/
+    std::vector<uint8_t> finals;/**< - finals[state] is 1 if the state is final;*/
+
+public:
+    static const uint32_t DEAD = 0;/**< - the dead state;*/
+    static const uint32_t DEFAULT_MAX_STATES = 1 << 16;/**< - default limit on the number of DFA states;*/
+
+    DFA();
+
+    void reset(const ByteClasses& classes);
+    uint32_t addState(bool isFinal);
+    void setTransition(uint32_t from, uint32_t byteClass, uint32_t to);
+    void setStart(uint32_t state);
+
+    uint32_t getStatesNum() const;
+    uint32_t getAlphabetSize() const;
+    const ByteClasses& getClasses() const;
+    uint32_t getStart() const;
+    const uint32_t* getTable() const;
+
+    /**
+     * @param state - a DFA state;
+     * @param symbol - the input byte;
+     * @return the state we reach from state with symbol.
+     */
+    uint32_t next(uint32_t state, unsigned char symbol) const{
+        return table[state * alphabetSize + classes.classOf[symbol]];
+    }
+
+    /**
+     * @param state - a DFA state;
+     * @return true if the state is final and false otherwise.
+     */
+    bool isFinal(uint32_t state) const{
+        return finals[state] != 0;
+    }
+
+    bool compile(const Simulator&, uint32_t = DEFAULT_MAX_STATES, bool = false);
+    bool recognise(const char*, size_t) const;
+    MinimizationStats minimize();
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file EpsilonClosure.cpp
+ * @details Contains the definitions of the ε-closure computation and the ε-elimination of NFA.
+ */
+
+#include<algorithm>
+#include<utility>
+#include"EpsilonClosure.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+
+/**
+ * @brief Constructor
+ * @details Iterative Tarjan's algorithm over the ε-transitions. Tarjan's algorithm finishes every component after all
+ * the components reachable from it, so the closures can be computed right when a component is finished.
+ *
+ * @param index - reference to an object of type NFAIndex;
+ */
+EpsilonClosure::EpsilonClosure(const NFAIndex& index) : hasEpsilon(false){
+    int statesNum = index.getStatesNum();
+    const int none = -1;
+
+    //the ε-transitions of every state are a contiguous range because the transitions are sorted by literal
+    std::vector<int> epsilonBegin(statesNum), epsilonEnd(statesNum);
+    for(int q = 0; q < statesNum; q++){
+        index.find(q, '^', epsilonBegin[q], epsilonEnd[q]);
+        if(epsilonBegin[q] != epsilonEnd[q])
+            hasEpsilon = true;
+    }
+
+    components.assign(statesNum, none);
+    std::vector<int> order(statesNum, none), lowLink(statesNum, 0), next(statesNum, 0);
+    std::vector<int> stack, callStack;
+    std::vector<bool> onStack(statesNum, false);
+    int counter = 0;
+
+    for(int root = 0; root < statesNum; root++){
+        if(order[root] != none)
+            continue;
+
+        callStack.push_back(root);
+        while(!callStack.empty()){
+            int q = callStack.back();
+            if(order[q] == none){
+                order[q] = lowLink[q] = counter++;
+                next[q] = epsilonBegin[q];
+                stack.push_back(q);
+                onStack[q] = true;
+            }
+
+            //visits the next unvisited ε-successor, if there is one
+            bool descended = false;
+            while(next[q] < epsilonEnd[q]){
+                int r = index.targetAt(next[q]++);
+                if(order[r] == none){
+                    callStack.push_back(r);
+                    descended = true;
+                    break;
+                }
+                if(onStack[r])
+                    lowLink[q] = std::min(lowLink[q], order[r]);
+            }
+            if(descended)
+                continue;
+
+            callStack.pop_back();
+            if(!callStack.empty())
+                lowLink[callStack.back()] = std::min(lowLink[callStack.back()], lowLink[q]);
+
+            //q is the root of a component - pops the component and computes its closure
+            if(lowLink[q] == order[q]){
+                int component = int(closures.size());
+                closures.push_back(StateSet(statesNum));
+                StateSet& closure = closures.back();
+
+                std::vector<int> members;
+                int member;
+                do{
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    components[member] = component;
+                    closure.insert(member);
+                    members.push_back(member);
+                }while(member != q);
+
+                for(size_t i = 0; i < members.size(); i++){
+                    for(int j = epsilonBegin[members[i]]; j < epsilonEnd[members[i]]; j++){
+                        int target = components[index.targetAt(j)];
+                        if(target != component && !closure.contains(index.targetAt(j)))
+                            closure.unite(closures[target]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @return the number of strongly connected components of the ε-transitions.
+ */
+int EpsilonClosure::getComponentsNum() const{
+    return int(closures.size());
+}
+
+/**
+ * @return true if the NFA has at least one ε-transition and false otherwise.
+ */
+bool EpsilonClosure::hasEpsilonTransitions() const{
+    return hasEpsilon;
+}
+
+/**
+ * @brief Builds equivalent NFA without ε-transitions.
+ * @details State p gets transition p -a-> r for every non-ε transition q -a-> r of a state q in the ε-closure of p,
+ * and p is final if its ε-closure has a final state. The states and the initial state keep their names.
+ *
+ * @return the ε-free NFA, with the same identifier.
+ * @see EpsilonClosure
+ */
+NFA NFA::removeEpsilon() const{
+    NFAIndex index(*this);
+    EpsilonClosure closure(index);
+    int statesNum = index.getStatesNum();
+
+    NFA result(nullptr, statesNum, 0, nullptr, currentTransitionsNum, 0);
+    result.setID(ID);
+
+    std::vector<bool> finals(statesNum, false);
+    for(int p = 0; p < statesNum; p++)
+        finals[p] = closure.of(p).intersects(index.getFinals());
+
+    //the states from the states array keep their order, the states that were only in transitions are added after them
+    for(int p = 0; p < statesNum; p++)
+        result.addState(State(index.nameOf(p), finals[p]));
+    result.setInitialState(State(initialState.name, finals[index.getStart()]));
+
+    std::vector<std::pair<unsigned char, int> > edges;
+    for(int p = 0; p < statesNum; p++){
+        edges.clear();
+        closure.of(p).forEach([&](int q){
+            for(int i = index.begin(q); i < index.end(q); i++){
+                if(index.literalAt(i) != '^')
+                    edges.push_back(std::make_pair((unsigned char)index.literalAt(i), index.targetAt(i)));
+            }
+        });
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        for(size_t i = 0; i < edges.size(); i++)
+            result.addTransition(Transition(index.nameOf(p), index.nameOf(edges[i].second), (char)edges[i].first));
+    }
+    return result;
+}
@@ -0,0 +1,43 @@
+/**
+ * \headerfile EpsilonClosure.h
+ * @details Contains the declaration of the ε-closure computation.
+ */
+
+#ifndef NFA_EPSILONCLOSURE_H
+#define NFA_EPSILONCLOSURE_H
+
+#include<vector>
+#include"StateSet.h"
+
+class NFAIndex;
+
+/**
+ * @class EpsilonClosure
+ * @brief The ε-closures of all the states of a NFA.
+ * @details The ε-transitions are condensed into strongly connected components first - all the states of a component
+ * have the same closure, so it's stored once per component. Components are processed in reverse topological order and
+ * the closure of a component is its states united with the closures of the components it has ε-transitions to. That
+ * handles ε-cycles and costs O(n + m) graph work plus O(m * n / 64) for the bitset unions.
+ */
+class EpsilonClosure{
+private:
+    std::vector<int> components;/**< - components[q] is the component of state q;*/
+    std::vector<StateSet> closures;/**< - closures[c] is the ε-closure of every state of component c;*/
+    bool hasEpsilon;/**< - shows if the NFA has at least one ε-transition;*/
+
+public:
+    explicit EpsilonClosure(const NFAIndex&);
+
+    /**
+     * @param state - dense index of a state;
+     * @return the ε-closure of the state.
+     */
+    const StateSet& of(int state) const{
+        return closures[components[state]];
+    }
+
+    int getComponentsNum() const;
+    bool hasEpsilonTransitions() const;
+};
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file Equivalence.cpp
+ * @details Contains the definitions of the language equivalence and inclusion checks.
+ */
+
+#include<algorithm>
+#include<unordered_map>
+#include<utility>
+#include<vector>
+#include"NFA.h"
+#include"NFAIndex.h"
+#include"Simulator.h"
+
+/**
+ * @brief Builds the word that leads to a node of a search tree.
+ *
+ * @param parents - parents[k] is the node node k was reached from, -1 for the root;
+ * @param symbols - symbols[k] is the symbol node k was reached with;
+ * @param node - the node;
+ * @return the symbols on the path from the root to the node.
+ */
+static std::string pathTo(const std::vector<int>& parents, const std::vector<char>& symbols, int node){
+    std::string word;
+    for(; parents[node] != -1; node = parents[node])
+        word += symbols[node];
+    std::reverse(word.begin(), word.end());
+    return word;
+}
+
+/**
+ * @brief Checks if two NFA recognize the same language.
+ * @details Hopcroft-Karp algorithm on the subset constructions of the two NFA, which are built on the fly: the subsets
+ * of both NFA are numbered in one union-find, the pair of the initial subsets is merged first, and every pair taken
+ * from the queue merges its successors on every symbol. If a pair with one accepting and one non-accepting subset is
+ * reached, the word that led to it is in exactly one of the languages. Breadth-first order makes it a shortest one.
+ *
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @param counterexample - receives word recognized by only one of the NFA if they aren't equivalent;
+ * @return true if the NFA are equivalent and false otherwise.
+ */
+bool NFA::equivalent(const NFA& one, const NFA& two, std::string& counterexample){
+    Simulator first(one), second(two);
+    std::vector<unsigned char> symbols;
+    for(int c = 0; c < 256; c++){
+        if(first.usesSymbol((unsigned char)c) || second.usesSymbol((unsigned char)c))
+            symbols.push_back((unsigned char)c);
+    }
+
+    //the subsets of both NFA are numbered together, ids[0] has the subsets of the first one and ids[1] of the second
+    std::unordered_map<StateSet, int, StateSetHash> ids[2];
+    std::vector<StateSet> sets;
+    std::vector<int> parent;
+    auto idOf = [&](int side, const StateSet& set){
+        std::pair<std::unordered_map<StateSet, int, StateSetHash>::iterator, bool> inserted =
+                ids[side].insert(std::make_pair(set, int(sets.size())));
+        if(inserted.second){
+            sets.push_back(set);
+            parent.push_back(int(parent.size()));
+        }
+        return inserted.first->second;
+    };
+    auto find = [&](int x){
+        while(parent[x] != x){
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    //the queue of the pairs and the search tree used to build the counterexample
+    std::vector<std::pair<int, int> > pairs;
+    std::vector<int> from;
+    std::vector<char> by;
+
+    StateSet set(first.getStatesNum()), other(second.getStatesNum());
+    first.startSet(set);
+    second.startSet(other);
+    int x = idOf(0, set), y = idOf(1, other);
+    parent[x] = y;
+    pairs.push_back(std::make_pair(x, y));
+    from.push_back(-1);
+    by.push_back(0);
+
+    for(size_t k = 0; k < pairs.size(); k++){
+        const StateSet& left = sets[pairs[k].first];
+        const StateSet& right = sets[pairs[k].second];
+        if(first.isAccepting(left) != second.isAccepting(right)){
+            counterexample = pathTo(from, by, int(k));
+            return false;
+        }
+
+        for(size_t i = 0; i < symbols.size(); i++){
+            first.step(sets[pairs[k].first], symbols[i], set);
+            second.step(sets[pairs[k].second], symbols[i], other);
+            x = idOf(0, set);
+            y = idOf(1, other);
+            int rootX = find(x), rootY = find(y);
+            if(rootX != rootY){
+                parent[rootX] = rootY;
+                pairs.push_back(std::make_pair(x, y));
+                from.push_back(int(k));
+                by.push_back(char(symbols[i]));
+            }
+        }
+    }
+    counterexample.clear();
+    return true;
+}
+
+/**
+ * @brief Checks if the language of one NFA includes the language of another.
+ * @details Antichain algorithm: searches the pairs (q, S) of a state q of the ε-free second NFA and the set S of
+ * active states of the first NFA after the same word. A pair with final q and non-accepting S gives a word that only
+ * the second NFA recognizes. A pair (q, S) isn't explored if a pair (q, S') with S' ⊆ S was already found - every
+ * counterexample from (q, S) is also a counterexample from (q, S') - so usually only a small part of the subset
+ * construction of the first NFA is built.
+ *
+ * @param one - reference to the NFA whose language should be the bigger one;
+ * @param two - reference to the NFA whose language should be the smaller one;
+ * @param counterexample - receives word recognized by two and not by one if the inclusion doesn't hold;
+ * @return true if every word of two is recognized by one and false otherwise.
+ */
+bool NFA::includes(const NFA& one, const NFA& two, std::string& counterexample){
+    Simulator first(one);
+    NFAIndex second(two.removeEpsilon());
+
+    //antichain[q] are the positions of the minimal sets found with state q
+    std::vector<std::vector<int> > antichain(second.getStatesNum());
+    std::vector<std::pair<int, StateSet> > pairs;
+    std::vector<int> from;
+    std::vector<char> by;
+    auto add = [&](int q, const StateSet& set, int parentPair, char symbol){
+        std::vector<int>& chain = antichain[q];
+        for(size_t i = 0; i < chain.size(); i++){
+            if(pairs[chain[i]].second.isSubsetOf(set))
+                return;
+        }
+        //the sets the new one is smaller than are no longer minimal
+        size_t kept = 0;
+        for(size_t i = 0; i < chain.size(); i++){
+            if(!set.isSubsetOf(pairs[chain[i]].second))
+                chain[kept++] = chain[i];
+        }
+        chain.resize(kept);
+        chain.push_back(int(pairs.size()));
+        pairs.push_back(std::make_pair(q, set));
+        from.push_back(parentPair);
+        by.push_back(symbol);
+    };
+
+    StateSet set(first.getStatesNum());
+    first.startSet(set);
+    add(second.getStart(), set, -1, 0);
+
+    for(size_t k = 0; k < pairs.size(); k++){
+        int q = pairs[k].first;
+        if(second.isFinal(q) && !first.isAccepting(pairs[k].second)){
+            counterexample = pathTo(from, by, int(k));
+            return false;
+        }
+
+        for(int i = second.begin(q); i < second.end(q); i++){
+            first.step(pairs[k].second, (unsigned char)second.literalAt(i), set);
+            add(second.targetAt(i), set, int(k), second.literalAt(i));
+        }
+    }
+    counterexample.clear();
+    return true;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file LazyDFA.cpp
+ * @details Contains the definitions of the lazily built DFA with bounded memory.
+ */
+
+#include"LazyDFA.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+
+const uint32_t LazyDFA::UNKNOWN;
+const size_t LazyDFA::DEFAULT_MEMORY_BUDGET;
+
+/**
+ * @brief Constructor
+ * @param nfa - reference to an object of type NFA;
+ * @param memoryBudget - maximum number of bytes the cache may use;
+ * @see LazyDFA(const NFAIndex& index, size_t memoryBudget)
+ */
+LazyDFA::LazyDFA(const NFA& nfa, size_t memoryBudget) : LazyDFA(NFAIndex(nfa), memoryBudget){
+}
+
+/**
+ * @brief Constructor
+ * @details Creates only the dead state and the initial state. All the other states are created on demand.
+ *
+ * @param index - the index of the NFA;
+ * @param memoryBudget - maximum number of bytes the cache may use;
+ */
+LazyDFA::LazyDFA(const NFAIndex& index, size_t memoryBudget) : simulator(index), memoryBudget(memoryBudget),
+                                                                 memoryUsed(0), flushesNum(0), start(0){
+    classes = simulator.getClasses();
+
+    flush();
+    flushesNum = 0;
+}
+
+/**
+ * @return approximate number of bytes one cached state uses - its table row, its set stored twice (in sets and as a
+ * hash map key) and the hash map node.
+ */
+size_t LazyDFA::stateCost() const{
+    size_t setBytes = (simulator.getStatesNum() + 63) / 64 * sizeof(uint64_t);
+    return classes.count * sizeof(uint32_t) + 2 * (setBytes + sizeof(StateSet)) + 4 * sizeof(void*) + 1;
+}
+
+/**
+ * @details Adds new DFA state for a set of NFA states. All its transitions are unknown.
+ * @param set - reference to an object of type StateSet;
+ * @return the new state.
+ */
+uint32_t LazyDFA::addState(const StateSet& set){
+    uint32_t id = uint32_t(sets.size());
+    ids[set] = id;
+    sets.push_back(set);
+    table.resize(table.size() + classes.count, UNKNOWN);
+    finals.push_back(simulator.isAccepting(set) ? 1 : 0);
+    memoryUsed += stateCost();
+    return id;
+}
+
+/**
+ * @brief Removes all the cached states.
+ * @details Leaves only the dead state (0) and the initial state (1).
+ */
+void LazyDFA::flush(){
+    ids.clear();
+    sets.clear();
+    table.clear();
+    finals.clear();
+    memoryUsed = 0;
+    flushesNum++;
+
+    StateSet set(simulator.getStatesNum());
+    addState(set);
+    //transitions of the dead state are known - they all lead back to it
+    for(uint32_t byteClass = 0; byteClass < classes.count; byteClass++)
+        table[byteClass] = 0;
+
+    simulator.startSet(set);
+    start = addState(set);
+}
+
+/**
+ * @details Computes transition that isn't in the cache yet. If the new state doesn't fit in the memory budget, the
+ * cache is flushed first - then the returned state and the states numbers used by the caller so far are no longer
+ * related, so the caller must continue only with the returned state.
+ *
+ * @param state - the from-state;
+ * @param symbol - the symbol of the transition;
+ * @return the to-state.
+ */
+uint32_t LazyDFA::compute(uint32_t state, unsigned char symbol){
+    StateSet next(simulator.getStatesNum());
+    simulator.step(sets[state], symbol, next);
+
+    std::unordered_map<StateSet, uint32_t, StateSetHash>::iterator found = ids.find(next);
+    if(found != ids.end()){
+        table[state * classes.count + classes.classOf[symbol]] = found->second;
+        return found->second;
+    }
+
+    if(memoryUsed + stateCost() > memoryBudget){
+        flush();
+        found = ids.find(next);
+        if(found != ids.end())
+            return found->second;
+        return addState(next);
+    }
+
+    uint32_t to = addState(next);
+    table[state * classes.count + classes.classOf[symbol]] = to;
+    return to;
+}
+
+/**
+ * @brief Checks if the NFA recognizes word.
+ * @details Known transitions are one table lookup; unknown ones are computed and memoized.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+bool LazyDFA::recognise(const char* word, size_t length){
+    uint32_t state = start;
+    for(size_t i = 0; i < length; i++){
+        unsigned char symbol = word[i];
+        uint32_t next = table[state * classes.count + classes.classOf[symbol]];
+        if(next == UNKNOWN)
+            next = compute(state, symbol);
+        if(next == 0)
+            return false;
+        state = next;
+    }
+    return finals[state] != 0;
+}
+
+/**
+ * @return the number of DFA states in the cache, including the dead state.
+ */
+size_t LazyDFA::getStatesNum() const{
+    return sets.size();
+}
+
+/**
+ * @return approximate number of bytes the cache uses.
+ */
+size_t LazyDFA::getMemoryUsed() const{
+    return memoryUsed;
+}
+
+/**
+ * @return how many times the cache has been flushed because the memory budget was reached.
+ */
+size_t LazyDFA::getFlushesNum() const{
+    return flushesNum;
+}
@@ -0,0 +1,61 @@
+/**
+ * \headerfile LazyDFA.h
+ * @details Contains the declaration of the lazily built DFA with bounded memory.
+ */
+
+#ifndef NFA_LAZYDFA_H
+#define NFA_LAZYDFA_H
+
+#include<cstddef>
+#include<cstdint>
+#include<unordered_map>
+#include<vector>
+#include"ByteClasses.h"
+#include"Simulator.h"
+#include"StateSet.h"
+
+/**
+ * @class LazyDFA
+ * @brief DFA that is built while words are being recognized.
+ * @details A DFA state (set of NFA states) and its transitions are created only when the input reaches them and are
+ * memoized for the next words. When the memoized states would use more memory than the budget allows, the whole cache
+ * is flushed and building starts again from the current state. The dead state, the initial state and the current
+ * state are always kept, so a budget smaller than three states makes the cache behave like plain simulation. The rows
+ * of the table are indexed by byte class, so a state costs |Σ| + 1 entries instead of 256.
+ * @see ByteClasses
+ */
+class LazyDFA{
+private:
+    static const uint32_t UNKNOWN = 0xFFFFFFFF;/**< - marks a transition that hasn't been computed yet;*/
+
+    Simulator simulator;/**< - the engine used to compute new DFA states;*/
+    ByteClasses classes;/**< - maps every byte to its column of the table;*/
+    size_t memoryBudget;/**< - maximum number of bytes the cache may use;*/
+    size_t memoryUsed;/**< - approximate number of bytes the cache uses now;*/
+    size_t flushesNum;/**< - how many times the cache has been flushed;*/
+    uint32_t start;/**< - the DFA state of the ε-closure of the initial state;*/
+
+    std::unordered_map<StateSet, uint32_t, StateSetHash> ids;/**< - maps a set of NFA states to its DFA state;*/
+    std::vector<StateSet> sets;/**< - sets[state] is the set of NFA states of a DFA state;*/
+    std::vector<uint32_t> table;/**< - table[state * classes.count + class] is the next state or UNKNOWN;*/
+    std::vector<uint8_t> finals;/**< - finals[state] is 1 if the state is final;*/
+
+    size_t stateCost() const;
+    uint32_t addState(const StateSet&);
+    void flush();
+    uint32_t compute(uint32_t, unsigned char);
+
+public:
+    static const size_t DEFAULT_MEMORY_BUDGET = 1 << 22;/**< - default memory budget of the cache, 4 MiB;*/
+
+    explicit LazyDFA(const NFA&, size_t = DEFAULT_MEMORY_BUDGET);
+    explicit LazyDFA(const NFAIndex&, size_t = DEFAULT_MEMORY_BUDGET);
+
+    bool recognise(const char*, size_t);
+
+    size_t getStatesNum() const;
+    size_t getMemoryUsed() const;
+    size_t getFlushesNum() const;
+};
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * @file MappedCatalog.cpp
+ * @details Contains the definitions of the memory-mapped, read-only view of binary NFA files.
+ */
+
+#ifdef _WIN32
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+#include"MappedCatalog.h"
+#include"NFAIndex.h"
+#include"Simulator.h"
+
+/**
+ * @brief Constructor
+ * @details Creates empty view.
+ */
+NFAView::NFAView() : id(0), initialState(), states(nullptr), statesNum(0), transitions(nullptr), transitionsNum(0){
+}
+
+/**
+ * @brief Constructor
+ * @details Indexes NFA straight from the records of a mapped binary file.
+ * @param view - reference to an object of type NFAView;
+ * @see build(const StateRecord* states, int statesCount, const TransitionRecord* transitions, int transitionsNum, const State& initialState)
+ */
+NFAIndex::NFAIndex(const NFAView& view) : statesNum(0), start(0){
+    build(view.states, view.statesNum, view.transitions, view.transitionsNum, view.initialState);
+}
+
+/**
+ * @brief Checks if the NFA recognizes word.
+ * @details The NFA is indexed straight from the mapped records.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+bool NFAView::recognise(const char* word, size_t length) const{
+    Simulator simulator((NFAIndex(*this)));
+    return simulator.recognise(word, length);
+}
+
+/**
+ * @details Copies the view into NFA that can be changed.
+ * @return the copied NFA.
+ */
+NFA NFAView::toNFA() const{
+    NFA nfa(nullptr, statesNum, 0, nullptr, transitionsNum, 0);
+    nfa.setID(id);
+    nfa.setInitialState(initialState);
+    for(int i = 0; i < statesNum; i++)
+        nfa.addState(State(states[i].name, states[i].isFinal != 0));
+    for(int i = 0; i < transitionsNum; i++)
+        nfa.addTransition(Transition(transitions[i].from, transitions[i].to, (char)transitions[i].literal));
+    return nfa;
+}
+
+/**
+ * @brief Constructor
+ * @details Creates catalog with no file opened.
+ */
+MappedCatalog::MappedCatalog() : data(nullptr), size(0), index(nullptr), automataNum(0){
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#endif
+}
+
+/**
+ * @brief Destructor.
+ * @see close()
+ */
+MappedCatalog::~MappedCatalog(){
+    close();
+}
+
+/**
+ * @brief Maps binary NFA file to memory.
+ * @details Only the file header is checked here, the records are checked when they are accessed.
+ *
+ * @param name - the name of the file;
+ * @return true if the file was mapped and is in the supported format and false otherwise.
+ */
+bool MappedCatalog::open(const std::string& name){
+    close();
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                             nullptr);
+    if(fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart < LONGLONG(sizeof(BinaryFileHeader))){
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mappingHandle == nullptr){
+        close();
+        return false;
+    }
+    data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if(data == nullptr){
+        close();
+        return false;
+    }
+    size = size_t(fileSize.QuadPart);
+#else
+    int descriptor = ::open(name.c_str(), O_RDONLY);
+    if(descriptor < 0)
+        return false;
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || status.st_size < off_t(sizeof(BinaryFileHeader))){
+        ::close(descriptor);
+        return false;
+    }
+    void* mapping = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    //the mapping stays valid after the descriptor is closed
+    ::close(descriptor);
+    if(mapping == MAP_FAILED)
+        return false;
+    data = (const char*)mapping;
+    size = size_t(status.st_size);
+#endif
+
+    const BinaryFileHeader* header = (const BinaryFileHeader*)data;
+    if(header->magic != BinaryCatalog::MAGIC || header->version != BinaryCatalog::VERSION ||
+       sizeof(BinaryFileHeader) + uint64_t(header->automataNum) * sizeof(BinaryIndexEntry) > size){
+        close();
+        return false;
+    }
+    automataNum = header->automataNum;
+    index = (const BinaryIndexEntry*)(data + sizeof(BinaryFileHeader));
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ * @details All the views taken from the catalog become invalid.
+ */
+void MappedCatalog::close(){
+#ifdef _WIN32
+    if(data != nullptr)
+        UnmapViewOfFile(data);
+    if(mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+    if(fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if(data != nullptr)
+        munmap((void*)data, size);
+#endif
+    data = nullptr;
+    size = 0;
+    index = nullptr;
+    automataNum = 0;
+}
+
+/**
+ * @return true if a file is mapped and false otherwise.
+ */
+bool MappedCatalog::isOpen() const{
+    return data != nullptr;
+}
+
+/**
+ * @return the number of automata in the mapped file.
+ */
+int MappedCatalog::getAutomataNum() const{
+    return int(automataNum);
+}
+
+/**
+ * @param position - position in the index, 0..getAutomataNum() - 1;
+ * @return the identifier of the automation at that position, the identifiers are in increasing order.
+ */
+int MappedCatalog::getID(int position) const{
+    return index[position].id;
+}
+
+/**
+ * @brief Finds NFA in the mapped file.
+ * @details Binary search in the mapped index. Nothing is copied - the view points into the mapping.
+ *
+ * @param id - identifier of the NFA we are searching;
+ * @param view - the view of the NFA;
+ * @return true if the NFA was found and its record fits in the file and false otherwise.
+ */
+bool MappedCatalog::find(int id, NFAView& view) const{
+    const BinaryIndexEntry* begin = index;
+    const BinaryIndexEntry* end = index + automataNum;
+    while(begin < end){
+        const BinaryIndexEntry* middle = begin + (end - begin) / 2;
+        if(middle->id < id)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    if(begin == index + automataNum || begin->id != id)
+        return false;
+
+    uint64_t offset = begin->offset;
+    if(offset % 8 != 0 || offset + sizeof(BinaryRecordHeader) > size)
+        return false;
+    const BinaryRecordHeader* header = (const BinaryRecordHeader*)(data + offset);
+    uint64_t recordEnd = offset + sizeof(BinaryRecordHeader) + uint64_t(header->statesNum) * sizeof(BinaryState) +
+                         uint64_t(header->transitionsNum) * sizeof(BinaryTransition);
+    if(recordEnd > size)
+        return false;
+
+    view.id = header->id;
+    view.initialState = State(header->initialState, header->initialFinal != 0);
+    view.states = (const BinaryState*)(data + offset + sizeof(BinaryRecordHeader));
+    view.statesNum = int(header->statesNum);
+    view.transitions = (const BinaryTransition*)(view.states + header->statesNum);
+    view.transitionsNum = int(header->transitionsNum);
+    return true;
+}
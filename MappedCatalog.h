@@ -0,0 +1,69 @@
+/**
+ * \headerfile MappedCatalog.h
+ * @details Contains the declarations of the memory-mapped, read-only view of binary NFA files.
+ */
+
+#ifndef NFA_MAPPEDCATALOG_H
+#define NFA_MAPPEDCATALOG_H
+
+#include<cstddef>
+#include<cstdint>
+#include<string>
+#include"BinaryCatalog.h"
+#include"NFA.h"
+
+/**
+ * @struct NFAView
+ * @brief Read-only NFA whose states and transitions are stored somewhere else.
+ * @details The arrays point straight into a mapped binary file, so creating a view doesn't allocate or copy anything.
+ * The view is valid while the MappedCatalog it came from is open.
+ * @see MappedCatalog
+ */
+struct NFAView{
+    int id;/**< - the identifier of the NFA;*/
+    State initialState;/**< - the initial state of the NFA;*/
+    const BinaryState* states;/**< - the states of the NFA;*/
+    int statesNum;/**< - number of states;*/
+    const BinaryTransition* transitions;/**< - the transitions of the NFA;*/
+    int transitionsNum;/**< - number of transitions;*/
+
+    NFAView();
+
+    bool recognise(const char*, size_t) const;
+    NFA toNFA() const;
+};
+
+/**
+ * @class MappedCatalog
+ * @brief Memory-mapped binary NFA file.
+ * @details The whole file is mapped read-only and the index and records are used in place. Opening costs the same no
+ * matter how big the file is and processes that map the same file share its pages.
+ */
+class MappedCatalog{
+private:
+    const char* data;/**< - the beginning of the mapping;*/
+    size_t size;/**< - size of the mapping in bytes;*/
+    const BinaryIndexEntry* index;/**< - the index of the file, sorted by ID;*/
+    uint32_t automataNum;/**< - number of automata in the file;*/
+#ifdef _WIN32
+    void* fileHandle;/**< - handle of the opened file;*/
+    void* mappingHandle;/**< - handle of the file mapping;*/
+#endif
+
+    MappedCatalog(const MappedCatalog&);
+    MappedCatalog& operator=(const MappedCatalog&);
+
+public:
+    MappedCatalog();
+    ~MappedCatalog();
+
+    bool open(const std::string&);
+    void close();
+    bool isOpen() const;
+
+    int getAutomataNum() const;
+    int getID(int) const;
+    bool find(int, NFAView&) const;
+};
+
+#endif
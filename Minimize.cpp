@@ -0,0 +1,248 @@
+/**
+ * @file Minimize.cpp
+ * @details Contains Hopcroft's DFA minimization and the refinable partition it uses.
+ */
+
+#include<utility>
+#include<vector>
+#include"DFA.h"
+
+/**
+ * @class RefinablePartition
+ * @brief Partition of 0..n-1 into blocks that can be split in time proportional to the marked elements.
+ * @details The elements of every block are contiguous in elements[]; marked elements are moved to the front of their
+ * block, so splitting a block is only moving its boundaries.
+ */
+class RefinablePartition{
+private:
+    std::vector<uint32_t> elements;/**< - the elements, block by block;*/
+    std::vector<uint32_t> location;/**< - location[e] is the position of e in elements;*/
+    std::vector<uint32_t> blockOf;/**< - blockOf[e] is the block of e;*/
+    std::vector<uint32_t> first;/**< - first[b] is the position of the first element of block b;*/
+    std::vector<uint32_t> end;/**< - end[b] is the position after the last element of block b;*/
+    std::vector<uint32_t> marked;/**< - the marked elements of block b are [first[b], marked[b]);*/
+    std::vector<uint32_t> touched;/**< - the blocks with marked elements;*/
+
+public:
+    /**
+     * @brief Constructor
+     * @details Creates partition with one block for every distinct value of key.
+     * @param key - key[e] is the initial group of e, 0 or 1;
+     */
+    explicit RefinablePartition(const std::vector<uint8_t>& key) : elements(key.size()), location(key.size()),
+                                                                   blockOf(key.size()){
+        uint32_t n = uint32_t(key.size()), position = 0;
+        for(uint8_t value = 0; value < 2; value++){
+            uint32_t begin = position;
+            for(uint32_t e = 0; e < n; e++){
+                if(key[e] == value){
+                    elements[position] = e;
+                    location[e] = position++;
+                    blockOf[e] = uint32_t(first.size());
+                }
+            }
+            if(position > begin){
+                first.push_back(begin);
+                end.push_back(position);
+                marked.push_back(begin);
+            }
+        }
+    }
+
+    uint32_t blocksNum() const{
+        return uint32_t(first.size());
+    }
+
+    uint32_t size(uint32_t block) const{
+        return end[block] - first[block];
+    }
+
+    uint32_t block(uint32_t element) const{
+        return blockOf[element];
+    }
+
+    uint32_t begin(uint32_t block) const{
+        return first[block];
+    }
+
+    uint32_t finish(uint32_t block) const{
+        return end[block];
+    }
+
+    const uint32_t& at(uint32_t position) const{
+        return elements[position];
+    }
+
+    /**
+     * @details Moves element to the marked part of its block.
+     * @param element - the element we mark;
+     */
+    void mark(uint32_t element){
+        uint32_t b = blockOf[element], position = location[element];
+        if(position < marked[b])
+            return;
+        if(marked[b] == first[b])
+            touched.push_back(b);
+        uint32_t other = elements[marked[b]];
+        elements[position] = other;
+        location[other] = position;
+        elements[marked[b]] = element;
+        location[element] = marked[b];
+        marked[b]++;
+    }
+
+    /**
+     * @details Splits every touched block into its marked and unmarked part. The marked part becomes a new block unless
+     * the whole block is marked.
+     * @param created - the (old block, new block) pairs of the split blocks are added to it;
+     */
+    void split(std::vector<std::pair<uint32_t, uint32_t> >& created){
+        for(size_t i = 0; i < touched.size(); i++){
+            uint32_t b = touched[i];
+            if(marked[b] == end[b]){
+                marked[b] = first[b];
+                continue;
+            }
+            uint32_t fresh = uint32_t(first.size());
+            first.push_back(first[b]);
+            end.push_back(marked[b]);
+            marked.push_back(first[b]);
+            for(uint32_t position = first[b]; position < marked[b]; position++)
+                blockOf[elements[position]] = fresh;
+            first[b] = marked[b];
+            created.push_back(std::make_pair(b, fresh));
+        }
+        touched.clear();
+    }
+};
+
+/**
+ * @brief Minimizes the DFA.
+ * @details Hopcroft's algorithm: starts from the partition {final, not final} and splits blocks by (block, symbol)
+ * splitters taken from a worklist, always adding the smaller half of a split block, which gives O(n * k * log n)
+ * for n states and k symbols. The predecessors of every state are kept in inverse transition lists. Unreachable
+ * states are removed first. The dead state stays state 0 and all the states that can't reach a final state are merged
+ * into it.
+ *
+ * @return the number of states before and after minimization.
+ */
+MinimizationStats DFA::minimize(){
+    MinimizationStats stats;
+    stats.statesBefore = statesNum;
+    uint32_t k = alphabetSize;
+
+    //keeps only the states reachable from the initial state and the dead state
+    std::vector<uint32_t> renumber(statesNum, 0xFFFFFFFF), reachable;
+    renumber[DEAD] = 0;
+    reachable.push_back(DEAD);
+    if(renumber[start] == 0xFFFFFFFF){
+        renumber[start] = uint32_t(reachable.size());
+        reachable.push_back(start);
+    }
+    for(size_t i = 0; i < reachable.size(); i++){
+        for(uint32_t a = 0; a < k; a++){
+            uint32_t to = table[reachable[i] * k + a];
+            if(renumber[to] == 0xFFFFFFFF){
+                renumber[to] = uint32_t(reachable.size());
+                reachable.push_back(to);
+            }
+        }
+    }
+    uint32_t n = uint32_t(reachable.size());
+
+    //the inverse transitions: the predecessors of q on symbol a are inverse[inverseOffsets[a * n + q]..a * n + q + 1)
+    std::vector<uint32_t> inverseOffsets(size_t(k) * n + 1, 0), inverse(size_t(k) * n);
+    for(uint32_t p = 0; p < n; p++){
+        for(uint32_t a = 0; a < k; a++)
+            inverseOffsets[size_t(a) * n + renumber[table[reachable[p] * k + a]] + 1]++;
+    }
+    for(size_t i = 1; i < inverseOffsets.size(); i++)
+        inverseOffsets[i] += inverseOffsets[i - 1];
+    std::vector<uint32_t> fill(inverseOffsets.begin(), inverseOffsets.end() - 1);
+    for(uint32_t p = 0; p < n; p++){
+        for(uint32_t a = 0; a < k; a++)
+            inverse[fill[size_t(a) * n + renumber[table[reachable[p] * k + a]]]++] = p;
+    }
+
+    std::vector<uint8_t> key(n);
+    for(uint32_t p = 0; p < n; p++)
+        key[p] = finals[reachable[p]];
+    RefinablePartition partition(key);
+
+    //the worklist of (block, symbol) splitters
+    std::vector<std::pair<uint32_t, uint32_t> > worklist;
+    std::vector<uint8_t> waiting;
+    if(partition.blocksNum() == 2){
+        uint32_t smaller = partition.size(0) <= partition.size(1) ? 0 : 1;
+        waiting.assign(size_t(2) * k, 0);
+        for(uint32_t a = 0; a < k; a++){
+            worklist.push_back(std::make_pair(smaller, a));
+            waiting[size_t(smaller) * k + a] = 1;
+        }
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t> > created;
+    std::vector<uint32_t> members;
+    while(!worklist.empty()){
+        uint32_t splitter = worklist.back().first, a = worklist.back().second;
+        worklist.pop_back();
+        waiting[size_t(splitter) * k + a] = 0;
+
+        //marking may reorder the splitter block itself, so its states are copied first
+        members.assign(&partition.at(partition.begin(splitter)), &partition.at(partition.begin(splitter)) +
+                       partition.size(splitter));
+        for(size_t j = 0; j < members.size(); j++){
+            uint32_t q = members[j];
+            for(uint32_t i = inverseOffsets[size_t(a) * n + q]; i < inverseOffsets[size_t(a) * n + q + 1]; i++)
+                partition.mark(inverse[i]);
+        }
+
+        created.clear();
+        partition.split(created);
+        waiting.resize(size_t(partition.blocksNum()) * k, 0);
+        for(size_t i = 0; i < created.size(); i++){
+            uint32_t old = created[i].first, fresh = created[i].second;
+            for(uint32_t b = 0; b < k; b++){
+                uint32_t add;
+                if(waiting[size_t(old) * k + b])
+                    add = fresh;
+                else
+                    add = partition.size(fresh) <= partition.size(old) ? fresh : old;
+                if(!waiting[size_t(add) * k + b]){
+                    waiting[size_t(add) * k + b] = 1;
+                    worklist.push_back(std::make_pair(add, b));
+                }
+            }
+        }
+    }
+
+    //numbers the blocks - the block of the dead state is 0, the others in order of their first state
+    uint32_t blocks = partition.blocksNum();
+    std::vector<uint32_t> blockState(blocks, 0xFFFFFFFF), representative;
+    blockState[partition.block(0)] = 0;
+    representative.push_back(0);
+    for(uint32_t p = 0; p < n; p++){
+        uint32_t b = partition.block(p);
+        if(blockState[b] == 0xFFFFFFFF){
+            blockState[b] = uint32_t(representative.size());
+            representative.push_back(p);
+        }
+    }
+
+    std::vector<uint32_t> minimalTable(size_t(representative.size()) * k);
+    std::vector<uint8_t> minimalFinals(representative.size());
+    for(uint32_t s = 0; s < representative.size(); s++){
+        uint32_t old = reachable[representative[s]];
+        minimalFinals[s] = finals[old];
+        for(uint32_t a = 0; a < k; a++)
+            minimalTable[size_t(s) * k + a] = blockState[partition.block(renumber[table[old * k + a]])];
+    }
+
+    start = blockState[partition.block(renumber[start])];
+    statesNum = uint32_t(representative.size());
+    table.swap(minimalTable);
+    finals.swap(minimalFinals);
+
+    stats.statesAfter = statesNum;
+    return stats;
+}
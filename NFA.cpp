@@ -4,7 +4,6 @@
  */
 
 #include<iostream>
-#include<cstring>
 #include<cassert>
 #include<fstream>
 #include <sstream>
@@ -30,6 +29,7 @@ void NFA::Copy(const NFA& other){
 
     //the initial state is the other initial state
     initialState = other.initialState;
+    trimStats = other.trimStats;
 
     //creates new states array and puts in it the elements of the other states array
     states = new State[maxStatesNum];
@@ -45,6 +45,40 @@ void NFA::Copy(const NFA& other){
     for (int i = 0; i < currentTransitionsNum; i++)
         transitions[i] = other.transitions[i];
 
+    //the engines don't change, so the copy shares them
+    shiftAnd = other.shiftAnd;
+    simulator = other.simulator;
+}
+
+/**
+ * @brief Takes the resources of an existing object.
+ * @details The arrays of other are not copied - other is left with no states, no transitions and no arrays, but it can
+ * still be used or destroyed.
+ *
+ * @param other - reference to an object of type NFA;
+ */
+void NFA::Move(NFA& other){
+    ID = other.ID;
+
+    states = other.states;
+    currentStatesNum = other.currentStatesNum;
+    maxStatesNum = other.maxStatesNum;
+
+    transitions = other.transitions;
+    currentTransitionsNum = other.currentTransitionsNum;
+    maxTransitionsNum = other.maxTransitionsNum;
+
+    initialState = other.initialState;
+    trimStats = other.trimStats;
+    shiftAnd = std::move(other.shiftAnd);
+    simulator = std::move(other.simulator);
+
+    other.states = nullptr;
+    other.currentStatesNum = 0;
+    other.maxStatesNum = 0;
+    other.transitions = nullptr;
+    other.currentTransitionsNum = 0;
+    other.maxTransitionsNum = 0;
 }
 
 /**
@@ -55,6 +89,16 @@ void NFA::Erase(){
     delete [] transitions;
 }
 
+/**
+ * @details Forgets the engines built by recognise(), must be called whenever the states or the transitions change.
+ */
+void NFA::dropEngines(){
+    if(shiftAnd || simulator){
+        shiftAnd.reset();
+        simulator.reset();
+    }
+}
+
 /**
  * @brief Constructor
  * @details Default constructor, defined in a way that it can accept user-provided values as well. It's used to initialize a newly created NFA.
@@ -68,6 +112,7 @@ void NFA::Erase(){
  * */
 NFA::NFA(State* statesC, int maxStatesNum, int currentStatesNum, Transition* transitionsC, int maxTransitionsNum, int currentTransitionsNum){
     ID = autoCounter++;
+    trimStats = TrimStats();
 
     this->maxStatesNum = maxStatesNum;
     this->currentStatesNum = currentStatesNum;
@@ -99,6 +144,16 @@ NFA::NFA(const NFA& other){
     Copy(other);
 }
 
+/**
+ * @brief Move constructor
+ * @details Takes the states and transitions of a temporary object without copying them. The identifier is kept.
+ * @param other - rvalue reference to an object of type NFA
+ * @see Move(NFA&)
+ */
+NFA::NFA(NFA&& other) noexcept{
+    Move(other);
+}
+
 /**
  * @brief Assignment operator.
  * @details Used to copy values from one Transition to another already existing Transition.
@@ -115,6 +170,22 @@ NFA& NFA::operator=(const NFA& other){
     return *this;
 }
 
+/**
+ * @brief Move assignment operator.
+ * @details Releases the arrays of the NFA and takes the arrays of other without copying them.
+ *
+ * @param other - rvalue reference to an object of type NFA whose values we take;
+ * @return the value of the NFA specified by the left operand after the assignment.
+ * @see Move(NFA&) Erase()
+ */
+NFA& NFA::operator=(NFA&& other) noexcept{
+    if (this != &other){
+        Erase();
+        Move(other);
+    }
+    return *this;
+}
+
 /**
  * @brief Destructor.
  * @details Release any resources allocated by the object of type NFA.
@@ -192,35 +263,83 @@ State NFA::getInitialState() const{
     return initialState;
 }
 
+/**
+ * @details The combinators trim their result, so for a combined NFA these are the statistics of that trimming.
+ * @return how much the last trim() removed, all zeros if the NFA hasn't been trimmed.
+ * @see trim()
+ */
+TrimStats NFA::getTrimStats() const{
+    return trimStats;
+}
+
 /**
  * @details makes the given argument the initial state of the NFA.
  * @param state - reference to an object of type State;
  */
 void NFA::setInitialState(const State& state){
+    dropEngines();
     initialState = state;
 }
 
+/**
+ * @details Moves the states to a new array with the given capacity.
+ * @param capacity - the new maximum number of states, not less than the current number of states;
+ */
+void NFA::growStates(int capacity){
+    maxStatesNum = capacity;
+    //dynamically allocates new array of states and stores the NFA states in it, then deallocates the memory used for
+    //our states array and appropriates the buffer to states
+    State* buffer = new State[maxStatesNum];
+    for (int i = 0; i < currentStatesNum; i++){
+        buffer[i] = states[i];
+    }
+    delete[] states;
+    states = buffer;
+}
+
+/**
+ * @details Moves the transitions to a new array with the given capacity.
+ * @param capacity - the new maximum number of transitions, not less than the current number of transitions;
+ */
+void NFA::growTransitions(int capacity){
+    maxTransitionsNum = capacity;
+    //dynamically allocates new array of transitions and stores the NFA transitions in it, then deallocates the memory
+    // used for our transitions array and appropriates the buffer to transitions
+    Transition* buffer = new Transition[maxTransitionsNum];
+    for (int i = 0; i < currentTransitionsNum; i++) {
+        buffer[i] = transitions[i];
+    }
+    delete[] transitions;
+    transitions = buffer;
+}
+
+/**
+ * @brief Reserves memory for states and transitions.
+ * @details Increases the maximum number of states and transitions, so that adding up to the given numbers doesn't
+ * reallocate the arrays. Never decreases them.
+ *
+ * @param statesNum - the number of states the NFA should be able to hold;
+ * @param transitionsNum - the number of transitions the NFA should be able to hold;
+ */
+void NFA::reserve(int statesNum, int transitionsNum){
+    if (statesNum > maxStatesNum)
+        growStates(statesNum);
+    if (transitionsNum > maxTransitionsNum)
+        growTransitions(transitionsNum);
+}
+
 /**
  * @details Adds the state given as an argument to the states array of the NFA.
  *
  * @param state - reference to an object of type State;
- * @note If the current number of states is equal to the maximum number of states the program should increase the maximum
- * number of states first.
+ * @note If the current number of states is equal to the maximum number of states the program doubles the maximum
+ * number of states first, so adding n states costs O(n) in total.
  */
 void NFA::addState(const State& state){
     //checks if the maximum number of states is reached
-    if (currentStatesNum == maxStatesNum){
-        //increases the maximum number of states
-        ++maxStatesNum;
-        //dynamically allocates new array of states and stores the NFA states in it, then deallocates the memory used for
-        //our states array and appropriates the buffer to states
-        State* buffer = new State[maxStatesNum];
-        for (int i = 0; i<currentStatesNum; i++){
-            buffer[i] = states[i];
-        }
-        delete[] states;
-        states = buffer;
-    }
+    if (currentStatesNum == maxStatesNum)
+        growStates(maxStatesNum > 0 ? 2 * maxStatesNum : 1);
+    dropEngines();
     //adds the new state at the end of the array
     states[currentStatesNum++] = state;
 }
@@ -229,24 +348,14 @@ void NFA::addState(const State& state){
  * @details Adds the transition given as argument to the transitions array of the NFA.
  *
  * @param transition - reference to an object of type Transition;
- * @note If the current number of transitions is equal to the maximum number of transitions the program should increases the maximum
- * number of transitions first.
+ * @note If the current number of transitions is equal to the maximum number of transitions the program doubles the
+ * maximum number of transitions first, so adding n transitions costs O(n) in total.
 */
 void NFA::addTransition(const Transition& transition){
     //checks if the maximum number of transitions is reached
-    if (currentTransitionsNum == maxTransitionsNum) {
-        //increases the maximum number of transitions
-        ++maxTransitionsNum;
-        //dynamically allocates new array of transitions and stores the NFA transitions in it, then deallocates the memory
-        // used for our transitions array and appropriates the buffer to transitions
-        Transition* buffer = new Transition[maxTransitionsNum];
-        for (int i = 0; i < currentTransitionsNum; i++) {
-            buffer[i] = transitions[i];
-        }
-
-        delete[] transitions;
-        transitions = buffer;
-    }
+    if (currentTransitionsNum == maxTransitionsNum)
+        growTransitions(maxTransitionsNum > 0 ? 2 * maxTransitionsNum : 1);
+    dropEngines();
     //adds the new transition at the end of the array
     transitions[currentTransitionsNum++] = transition;
 }
@@ -256,6 +365,7 @@ void NFA::addTransition(const Transition& transition){
  * @param state - reference to an object of type State;
  */
 void NFA::setFinalState(const State& state){
+    dropEngines();
     for(int i = 0; i < currentStatesNum; i++) {
         if (states[i].name == state.name)
             states[i].isFinal = true;
@@ -263,35 +373,37 @@ void NFA::setFinalState(const State& state){
 }
 
 /**
- * @brief Prints the alphabet of the NFA.
+ * @brief Finds the alphabet of the NFA.
+ * @details One pass over the transitions with a table of the 256 byte values that are already in the alphabet, so it
+ * takes O(T) instead of searching the alphabet for every transition.
+ *
+ * @param alphabet - array of at least 256 chars, receives the literals in order of first appearance;
+ * @return the number of literals in the alphabet.
  */
-void NFA::getAlphabet() const{
-    int size = getCurrentTransitionsNum();
-    //dynamically allocates array of chars to store the alphabet
-    char* alphabet = new char[size];
+int NFA::collectAlphabet(char* alphabet) const{
+    bool seen[256] = {false};
     int numOfA = 0;
-    bool isThere = false;
-
-    //the first element of the array is the first transition's literal
-    alphabet[numOfA] = transitions[0].literal;
-
-    //check if the literal has already been reached so that it can miss it
-    for(int i = 1; i < currentTransitionsNum; i++){
-        for(int j = 0; j <= strlen(alphabet); j++){
-            if(transitions[i].literal == alphabet[j])
-                isThere = true;
-        }
+    for(int i = 0; i < currentTransitionsNum; i++){
+        unsigned char literal = transitions[i].literal;
         //if the literal hasn't been reached before the program adds it in the alphabet array
-        if(!isThere)
-            alphabet[++numOfA] = transitions[i].literal;
+        if(!seen[literal]){
+            seen[literal] = true;
+            alphabet[numOfA++] = transitions[i].literal;
+        }
     }
+    return numOfA;
+}
+
+/**
+ * @brief Prints the alphabet of the NFA.
+ */
+void NFA::getAlphabet() const{
+    char alphabet[256];
+    int numOfA = collectAlphabet(alphabet);
 
     //prints the alphabet
-    for(int i = 0; i <= numOfA; i++)
+    for(int i = 0; i < numOfA; i++)
         std::cout<<alphabet[i]<<" ";
-
-    //deallocates the memory used for the alphabet array
-    delete [] alphabet;
 }
 
 /**
@@ -386,7 +498,7 @@ void NFA::print() const {
  * @brief Adds NFA to file.
  * @param name - the name of the file in which we wil add the NFA;
  */
-void NFA::writeToFile(char* name){
+void NFA::writeToFile(const char* name){
     //opens file "name" for writing in it
     std::ofstream file(name, std::ios::out|std::ios::app|std::ios::ate);
     if(!file){
@@ -407,30 +519,10 @@ void NFA::writeToFile(char* name){
 
     //writes NFA's alphabet in the file
     file<<"Σ = { ";
-    int size = currentTransitionsNum;
-    //dynamically allocating array of chars to store the alphabet
-    char* alphabet = new char[size];
-    int numOfA = 0;
-    bool isThere = false;
-
-    //the first element of the array is the first transition's literal
-    alphabet[numOfA] = transitions[0].literal;
-
-    //check if the literal has already been reached so that it can miss it
-    for(int i = 1; i < currentTransitionsNum; i++){
-        for(int j = 0; j <= strlen(alphabet); j++){
-            if(transitions[i].literal == alphabet[j])
-                isThere = true;
-        }
-        //if the literal hasn't been reached before the program adds it in the alphabet array
-        if(!isThere)
-            alphabet[++numOfA] = transitions[i].literal;
-    }
-
-    for(int i = 0; i <= numOfA; i++)
+    char alphabet[256];
+    int numOfA = collectAlphabet(alphabet);
+    for(int i = 0; i < numOfA; i++)
         file<<" "<<alphabet[i]<<" ";
-
-    delete [] alphabet;
     file<< "}"<<std::endl;
 
     //writes NFA's initial state in the file
@@ -456,6 +548,7 @@ void NFA::writeToFile(char* name){
 /**
  * @details Used to search NFA through file.
  * @param id - identifier of the NFA we are searching;
+ * @see readFromStream(std::istream& file)
  */
 void NFA::readFromFile(int id){
     //opens file "tmp.txt" for reading
@@ -477,74 +570,83 @@ void NFA::readFromFile(int id){
             streamFile >> wordHelp >> found;
 
             //if it is the identifier we are searching
-            if (found == id) {
-                //reads another line from the file and stores it in another stream to read it element by element
-                getline(file, line);
-                std::stringstream stream(line);
-                std::string element;
-                int found;
-
-                //gets all the states names from the line and adds them to the states array
-                while (!stream.eof()) {
-                    stream >> element;
-                    if (std::stringstream(element) >> found) {
-                        State state;
-                        state.name = found;
-                        addState(state);
-                    }
-                }
-
-                //reads two new lines (to reach the initial state line) and puts it in stream
-                getline(file, line);
-                getline(file, line);
-                std::stringstream stream1(line);
-                //reads the stream element by element to reach the initial state name
-                while (!stream1.eof()) {
-                    stream1 >> element;
-                    if (std::stringstream(element) >> found) {
-                        State state;
-                        state.name = found;
-                        initialState = state;
-                    }
-                }
-
-                //reads the line with the final states and stores it in stream to get it element by element
-                getline(file, line);
-                std::stringstream stream2(line);
-                //while reading from the stream if the data is a state name makes it a final state
-                while (!stream2.eof()) {
-                    stream2 >> element;
-                    if (std::stringstream(element) >> found) {
-                        State state;
-                        state.name = found;
-                        setFinalState(state);
-                    }
-                }
-
-                //gets the line with the transitions and stores it in stream
-                getline(file, line);
-                Transition transition;
-                std::stringstream stream3(line);
-                //while reading from the stream gets the transitions and adds them to the transitions array of the NFA
-                while (!stream3.eof()) {
-                    stream3 >> element;
-                    if (std::stringstream(element) >> found) {
-                        transition.from = found;
-
-                        stream3 >> element;
-                        stream3 >> element;
-                        transition.literal = element[0];
-
-                        stream3 >> element;
-                        stream3 >> element;
-                        if (std::stringstream(element) >> found) {
-                            transition.to = found;
-                            addTransition(transition);
-                        }
-                        stream3 >> element;
-                    }
-                }
+            if (found == id)
+                readFromStream(file);
+        }
+    }
+}
+
+/**
+ * @details Reads the states, initial state, final states and transitions of NFA written by writeToFile(). The stream
+ * must be positioned right after the identifier line of the NFA.
+ * @param file - the stream we read from;
+ */
+void NFA::readFromStream(std::istream& file){
+    std::string line;
+    //reads another line from the file and stores it in another stream to read it element by element
+    getline(file, line);
+    std::stringstream stream(line);
+    std::string element;
+    int found;
+
+    //gets all the states names from the line and adds them to the states array
+    while (!stream.eof()) {
+        stream >> element;
+        if (std::stringstream(element) >> found) {
+            State state;
+            state.name = found;
+            addState(state);
+        }
+    }
+
+    //reads two new lines (to reach the initial state line) and puts it in stream
+    getline(file, line);
+    getline(file, line);
+    std::stringstream stream1(line);
+    //reads the stream element by element to reach the initial state name
+    while (!stream1.eof()) {
+        stream1 >> element;
+        if (std::stringstream(element) >> found) {
+            State state;
+            state.name = found;
+            setInitialState(state);
+        }
+    }
+
+    //reads the line with the final states and stores it in stream to get it element by element
+    getline(file, line);
+    std::stringstream stream2(line);
+    //while reading from the stream if the data is a state name makes it a final state
+    while (!stream2.eof()) {
+        stream2 >> element;
+        if (std::stringstream(element) >> found) {
+            State state;
+            state.name = found;
+            setFinalState(state);
+        }
+    }
+
+    //gets the line with the transitions and stores it in stream
+    getline(file, line);
+    Transition transition;
+    std::stringstream stream3(line);
+    //while reading from the stream gets the transitions and adds them to the transitions array of the NFA
+    while (!stream3.eof()) {
+        stream3 >> element;
+        if (std::stringstream(element) >> found) {
+            transition.from = found;
+
+            stream3 >> element;
+            stream3 >> element;
+            transition.literal = element[0];
+
+            stream3 >> element;
+            stream3 >> element;
+            if (std::stringstream(element) >> found) {
+                transition.to = found;
+                addTransition(transition);
             }
+            stream3 >> element;
         }
     }
 }
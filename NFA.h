@@ -6,6 +6,18 @@
 #ifndef NFA_NFA_H
 #define NFA_NFA_H
 
+#include<cstddef>
+#include<cstdint>
+#include<iosfwd>
+#include<memory>
+#include<string>
+#include<utility>
+#include<vector>
+
+class DFA;
+class ShiftAnd;
+class Simulator;
+
 /**
  * @struct State
  * @brief Used to present NFA states.
@@ -86,6 +98,17 @@ struct Transition{
     }
 };
 
+/**
+ * @struct TrimStats
+ * @brief Shows how much trimming shrank a NFA.
+ */
+struct TrimStats{
+    int statesBefore;/**< - number of states in the states array before trimming;*/
+    int statesAfter;/**< - number of states in the states array after trimming;*/
+    int transitionsBefore;/**< - number of transitions before trimming;*/
+    int transitionsAfter;/**< - number of transitions after trimming;*/
+};
+
 /**
  * @class NFA
  * @brief Non-deterministic finite automation with ε-transitions.
@@ -104,14 +127,26 @@ private:
     int currentTransitionsNum;/**< - current number of transitions that the NFA has;*/
     int maxTransitionsNum;/**< - maximum number of transitions that the NFA can have;*/
     State initialState;/**< - the initial state of the NFA;*/
+    TrimStats trimStats;/**< - how much the last trim() removed;*/
+    mutable std::shared_ptr<const ShiftAnd> shiftAnd;/**< - the bit-parallel engine, built by the first recognise;*/
+    mutable std::shared_ptr<const Simulator> simulator;/**< - the general engine, built by the first recognise of NFA ShiftAnd doesn't support;*/
 
     void Copy(const NFA&);
+    void Move(NFA&);
     void Erase();
+    void dropEngines();
+    void growStates(int);
+    void growTransitions(int);
+    void appendConcat(const NFA&);
+    void closePositive();
+    int collectAlphabet(char*) const;
 
 public:
     NFA(State* = nullptr, int = 10, int = 0, Transition* = nullptr, int = 10, int = 0);
     NFA(const NFA&);
+    NFA(NFA&&) noexcept;
     NFA& operator=(const NFA&);
+    NFA& operator=(NFA&&) noexcept;
     ~NFA();
 
     int getID() const;
@@ -122,8 +157,10 @@ public:
     int getCurrentTransitionsNum() const;
     int getMaxTransitionsNum() const;
     State getInitialState() const;
+    TrimStats getTrimStats() const;
 
     void setInitialState(const State&);
+    void reserve(int, int);
     void addState(const State&);
     void addTransition(const Transition&);
     void setFinalState(const State&);
@@ -132,18 +169,37 @@ public:
     void input();
     void getAlphabet() const;
     void print() const;
-    void writeToFile(char* name);
+    void writeToFile(const char* name);
     void readFromFile(int id);
+    void readFromStream(std::istream& file);
 
     void epsilonClosureADD();
+    NFA removeEpsilon() const;
+    NFA reversed() const;
+    TrimStats trim();
     bool isDeterministic() const;
+    bool isDeterministic(std::vector<std::pair<int, char> >&) const;
     bool isEmptyLanguage() const;
+    bool isEmptyLanguage(std::string&) const;
     void Union(const NFA&, const NFA&);
     void Concat(const NFA&, const NFA&);
     void Positive(const NFA&);
-
-    int help(int, char, Transition*) const;
-    bool recognise(char*);
+    void Intersect(const NFA&, const NFA&);
+    void Difference(const NFA&, const NFA&);
+
+    static NFA makeUnion(const NFA&, const NFA&);
+    static NFA makeConcat(const NFA&, const NFA&);
+    static NFA makeConcat(NFA&&, const NFA&);
+    static NFA makePositive(const NFA&);
+    static NFA makePositive(NFA&&);
+    static NFA makeIntersect(const NFA&, const NFA&);
+    static NFA makeDifference(const NFA&, const NFA&);
+    static bool equivalent(const NFA&, const NFA&, std::string&);
+    static bool includes(const NFA&, const NFA&, std::string&);
+
+    bool recognise(const char*) const;
+    bool recognise(const char*, size_t) const;
+    bool compileToDFA(DFA&, uint32_t = 1 << 16, bool = false) const;
 };
 
 #endif
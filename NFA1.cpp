@@ -3,50 +3,131 @@
  * @details Contains half of the NFA's functions definitions.
  */
 
+#include<algorithm>
+#include<deque>
 #include<iostream>
 #include<cstring>
+#include<memory>
+#include<utility>
+#include<vector>
 #include"NFA.h"
+#include"NFAIndex.h"
+#include"ShiftAnd.h"
+#include"Simulator.h"
 
 /**
- * @brief Adds all the epsilon transitions to the NFA.
+ * @brief Removes the epsilon transitions of the NFA.
+ * @details Replaces the NFA with the equivalent ε-free NFA, so the other algorithms can assume there are no '^'
+ * transitions.
+ * @see removeEpsilon() const
  */
 void NFA::epsilonClosureADD() {
-    for (int i = 0; i < currentTransitionsNum; i++) {
-        if (transitions[i].literal == '^') {
-            for (int j = 0; j < currentTransitionsNum; j++) {
-                if (transitions[j].from == transitions[i].to) {
-                    Transition newTrans(transitions[i].from, transitions[j].to, transitions[j].literal);
-                    addTransition(newTrans);
-                }
-            }
-        }
-    }
+    *this = removeEpsilon();
 }
 
 /**
  * @brief Checks whether the NFA is deterministic.
- * @details The NFA is deterministic if there is at most one transition from a given state for each letter of the NFA alphabet.
+ * @details The NFA is deterministic if there is at most one transition from a given state for each letter of the NFA
+ * alphabet and there are no ε-transitions.
  * @return true if the NFA is deterministic and false if otherwise.
+ * @see isDeterministic(std::vector<std::pair<int, char> >& conflicts) const
  */
 bool NFA::isDeterministic() const{
-    for(int i = 0; i < currentTransitionsNum - 1; ++i){
-        for(int j = i + 1; j < currentTransitionsNum; ++j){
-            if(transitions[i].from == transitions[j].from){
-                if(transitions[i].literal == transitions[j].literal && transitions[i].to != transitions[j].to){
-                    return false;
-                }
-            }
+    std::vector<std::pair<int, char> > conflicts;
+    return isDeterministic(conflicts);
+}
+
+/**
+ * @brief Checks whether the NFA is deterministic and finds where it isn't.
+ * @details The index groups the transitions by from-state and sorts every group by literal and to-state, which takes
+ * O(T log T) for T transitions, so two transitions with the same literal and different to-states are always
+ * neighbours. Every ε-transition makes the NFA nondeterministic, so a state with ε-transitions is a conflict on '^'.
+ *
+ * @param conflicts - receives every pair (state name, literal) that has more than one to-state, once;
+ * @return true if the NFA is deterministic and false if otherwise.
+ */
+bool NFA::isDeterministic(std::vector<std::pair<int, char> >& conflicts) const{
+    conflicts.clear();
+    NFAIndex index(*this);
+    for(int q = 0; q < index.getStatesNum(); q++){
+        for(int i = index.begin(q); i < index.end(q); i++){
+            char literal = index.literalAt(i);
+            //reports the literal only at its first conflicting transition
+            bool first = i == index.begin(q) || index.literalAt(i - 1) != literal;
+            if(literal == '^' && first)
+                conflicts.push_back(std::make_pair(index.nameOf(q), literal));
+            if(literal != '^' && !first && index.targetAt(i) != index.targetAt(i - 1) &&
+               (conflicts.empty() || conflicts.back() != std::make_pair(index.nameOf(q), literal)))
+                conflicts.push_back(std::make_pair(index.nameOf(q), literal));
         }
     }
-    return true;
+    return conflicts.empty();
 }
 
 /**
- * Checks if the NFA's language is empty(NFA has no transitions).
+ * Checks if the NFA's language is empty(no final state can be reached from the initial state).
  * @return true is NFA is empty and false if not.
+ * @see isEmptyLanguage(std::string& witness) const
  */
 bool NFA::isEmptyLanguage() const{
-    return currentTransitionsNum == 0;
+    std::string witness;
+    return isEmptyLanguage(witness);
+}
+
+/**
+ * @brief Checks if the NFA's language is empty and finds its shortest word.
+ * @details Breadth-first search from the initial state over the indexed transitions, which takes
+ * O(states + transitions). ε-transitions don't make the word longer, so they are taken before the other transitions
+ * (0-1 breadth-first search with a deque) and the first final state reached gives a shortest word of the language.
+ *
+ * @param witness - receives a shortest word of the language if the language isn't empty;
+ * @return true is NFA is empty and false if not.
+ */
+bool NFA::isEmptyLanguage(std::string& witness) const{
+    NFAIndex index(*this);
+    int statesNum = index.getStatesNum();
+
+    //the search tree: the state each state was reached from and the transition used
+    std::vector<int> distance(statesNum, -1), parent(statesNum, -1), via(statesNum, -1);
+    std::vector<bool> done(statesNum, false);
+    std::deque<int> queue;
+    distance[index.getStart()] = 0;
+    queue.push_back(index.getStart());
+
+    while(!queue.empty()){
+        int q = queue.front();
+        queue.pop_front();
+        if(done[q])
+            continue;
+        done[q] = true;
+
+        if(index.isFinal(q)){
+            witness.clear();
+            for(; parent[q] != -1; q = parent[q]){
+                if(index.literalAt(via[q]) != '^')
+                    witness += index.literalAt(via[q]);
+            }
+            std::reverse(witness.begin(), witness.end());
+            return false;
+        }
+
+        for(int i = index.begin(q); i < index.end(q); i++){
+            int to = index.targetAt(i);
+            bool epsilon = index.literalAt(i) == '^';
+            int length = distance[q] + (epsilon ? 0 : 1);
+            if(done[to] || (distance[to] != -1 && distance[to] <= length))
+                continue;
+            distance[to] = length;
+            parent[to] = q;
+            via[to] = i;
+            if(epsilon)
+                queue.push_front(to);
+            else
+                queue.push_back(to);
+        }
+    }
+    witness.clear();
+    return true;
 }
 
 /**
@@ -54,8 +135,13 @@ bool NFA::isEmptyLanguage() const{
  * @details makes union of two NFA
  * @param one - reference to an object of type NFA
  * @param two - reference to an object of type NFA
+ * @see trim()
  */
 void NFA::Union(const NFA& one, const NFA& two) {
+    //every state and transition of the two NFA is copied at most once (the initial self-loops are the only extra ones)
+    reserve(currentStatesNum + one.getCurrentStatesNum() + two.getCurrentStatesNum() + 1,
+            currentTransitionsNum + one.getCurrentTransitionsNum() + two.getCurrentTransitionsNum());
+
     //sets the initial state and adds it to the states array
     State state(0, false);
     setInitialState(state);
@@ -112,41 +198,32 @@ void NFA::Union(const NFA& one, const NFA& two) {
     if(one.getInitialState().isFinal || two.getInitialState().isFinal)
         initialState.isFinal = true;
 
+    trim();
 }
 
 /**
- * @details concatenates two NFA.
- * @param one - reference to an object of type NFA;
+ * @details Appends the second NFA of a concatenation to the states and transitions of the NFA, which holds the first
+ * NFA of the concatenation.
  * @param two - reference to an object of type NFA;
  */
-void NFA::Concat(const NFA& one, const NFA& two){
-    //the initial state of the concatenation NFA is the initial state of the first NFA
-    setInitialState(one.getInitialState());
-
-    //adds all the states from the first NFA to the concatenation NFA's states array
-    for(int i = 0; i < one.getCurrentStatesNum(); i++){
-        addState(one.states[i]);
-    }
+void NFA::appendConcat(const NFA& two){
+    int oneStatesNum = currentStatesNum;
+    reserve(currentStatesNum + two.getCurrentStatesNum(), currentTransitionsNum + two.getCurrentTransitionsNum());
 
     for(int j = 0; j < two.getCurrentStatesNum(); j++){
         if(two.states[j].name != two.initialState.name)
             addState(two.states[j]);
     }
 
-    //adds all the states from the first NFA to the concatenation NFA's states array(except these which are from the initial state)
-    for(int i = 0; i < one.getCurrentTransitionsNum(); i++){
-        addTransition(one.transitions[i]);
-    }
-
     //adds transitions from the first NFA final states to all the states that are in transition(to) with the initial state
     //of the second NFA
-    for(int i = 0; i < one.getCurrentStatesNum(); i++){
-        if(one.states[i].isFinal){
-            for(int j = 0; j < two.getCurrentTransitionsNum(); j++){
-                if(two.transitions[j].from == two.initialState.name){
-                    Transition transition(one.states[i].name, two.transitions[j].to, two.transitions[j].literal);
-                    addTransition(transition);
-                }
+    NFAIndex twoIndex(two);
+    int twoStart = twoIndex.getStart();
+    for(int i = 0; i < oneStatesNum; i++){
+        if(states[i].isFinal){
+            for(int j = twoIndex.begin(twoStart); j < twoIndex.end(twoStart); j++){
+                Transition transition(states[i].name, twoIndex.nameOf(twoIndex.targetAt(j)), twoIndex.literalAt(j));
+                addTransition(transition);
             }
         }
     }
@@ -159,124 +236,313 @@ void NFA::Concat(const NFA& one, const NFA& two){
     //if the initial state of the second NFA is final than all the final states from the first NFA are final in the
     //concatenation NFA as well
     if(!two.getInitialState().isFinal){
-        for(int i = 0; i < one.getCurrentStatesNum(); i++){
+        initialState.isFinal = false;
+        for(int i = 0; i < oneStatesNum; i++){
             states[i].isFinal = false;
         }
     }
+}
+
+/**
+ * @details concatenates two NFA.
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @see appendConcat(const NFA& two)
+ * @see trim()
+ */
+void NFA::Concat(const NFA& one, const NFA& two){
+    reserve(currentStatesNum + one.getCurrentStatesNum() + two.getCurrentStatesNum(),
+            currentTransitionsNum + one.getCurrentTransitionsNum() + two.getCurrentTransitionsNum());
+
+    //the initial state of the concatenation NFA is the initial state of the first NFA
+    setInitialState(one.getInitialState());
 
+    //adds all the states and transitions from the first NFA to the concatenation NFA
+    for(int i = 0; i < one.getCurrentStatesNum(); i++){
+        addState(one.states[i]);
+    }
+
+    for(int i = 0; i < one.getCurrentTransitionsNum(); i++){
+        addTransition(one.transitions[i]);
+    }
+
+    appendConcat(two);
+    trim();
+}
+
+/**
+ * @details Turns the NFA into its positive shell - adds transition from all the final states to all the states that
+ * are in transition(to) with the initial state.
+ */
+void NFA::closePositive(){
+    NFAIndex index(*this);
+    int start = index.getStart();
+    int statesNum = currentStatesNum;
+    for(int i = 0; i < statesNum; i++){
+        if(states[i].isFinal){
+            for(int j = index.begin(start); j < index.end(start); j++){
+                Transition transition(states[i].name, index.nameOf(index.targetAt(j)), index.literalAt(j));
+                addTransition(transition);
+            }
+        }
+    }
 }
 
 /**
  * @brief Positive shell of NFA.
  * @param one - reference to an object of type NFA;
+ * @see closePositive()
+ * @see trim()
  */
 void NFA::Positive(const NFA& one){
-    int number = 0;
+    reserve(currentStatesNum + one.getCurrentStatesNum(), currentTransitionsNum + one.getCurrentTransitionsNum());
+
     //the initial state of the NFA is the initial state of the one NFA
     setInitialState(one.getInitialState());
 
-    //adds all the states from the one NFA to the states array of the positive shell NFA
+    //adds all the states and transitions from the one NFA to the positive shell NFA
     for(int i = 0; i < one.getCurrentStatesNum(); i++){
         addState(one.states[i]);
     }
 
-    //adds all the transitions from the one NFA to the transitions array of the positive shell NFA and counts them
     for(int i = 0; i < one.getCurrentTransitionsNum(); i++){
         addTransition(one.transitions[i]);
-        number++;
     }
 
-    //adds transition from all the final states of the one NFA to all the states that are in transition(to) with the
-    //initial state and counts them
-    for(int i = 0; i < one.getCurrentStatesNum(); i++){
-        if(one.states[i].isFinal){
-            for(int j = 0; j < one.getCurrentTransitionsNum(); j++){
-                if(one.transitions[j].from == one.initialState.name){
-                    Transition transition(one.states[i].name, one.transitions[j].to, one.transitions[j].literal);
-                    addTransition(transition);
-                    number++;
-                }
-            }
-        }
-    }
+    closePositive();
+    trim();
+}
 
-    currentTransitionsNum = number;
+/**
+ * @brief Union of two NFA.
+ * @details Builds the union in a new NFA and returns it without copying.
+ *
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @return the union NFA.
+ * @see Union(const NFA& one, const NFA& two)
+ */
+NFA NFA::makeUnion(const NFA& one, const NFA& two){
+    NFA result(nullptr, 0, 0, nullptr, 0, 0);
+    result.Union(one, two);
+    return result;
 }
 
 /**
- * @details Help function to check were transition goes to
+ * @details Builds the concatenation of two NFA in a new NFA and returns it without copying.
  *
- * @param from - the from state of a transition;
- * @param literal - a literal used to pass in transition;
- * @param helpTransitions - dynamically allocated array of transitions;
- * @return - the first transition to-elemet that has from-element = "from" and literal = "literal"
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @return the concatenation NFA.
+ * @see Concat(const NFA& one, const NFA& two)
  */
-int NFA::help(int from, char literal, Transition* helpTransitions) const {
-    int newTo = 777;
-    for(int i=0;i<currentTransitionsNum;++i){
-        if(helpTransitions[i].from == from && literal == helpTransitions[i].literal){
-            newTo = helpTransitions[i].to;
-            break;
-        }
+NFA NFA::makeConcat(const NFA& one, const NFA& two){
+    NFA result(nullptr, 0, 0, nullptr, 0, 0);
+    result.Concat(one, two);
+    return result;
+}
+
+/**
+ * @details Builds the concatenation of two NFA in the arrays of the first one, so the first NFA isn't copied. Used
+ * for chaining, e.g. makeConcat(makeConcat(a, b), c).
+ *
+ * @param one - rvalue reference to an object of type NFA, it's left empty;
+ * @param two - reference to an object of type NFA;
+ * @return the concatenation NFA, with a new identifier.
+ * @see appendConcat(const NFA& two)
+ */
+NFA NFA::makeConcat(NFA&& one, const NFA& two){
+    NFA result(std::move(one));
+    //the result is a new NFA, so it doesn't keep the identifier of the moved one
+    result.setID(autoCounter++);
+    result.appendConcat(two);
+    result.trim();
+    return result;
+}
+
+/**
+ * @details Builds the positive shell of NFA in a new NFA and returns it without copying.
+ *
+ * @param one - reference to an object of type NFA;
+ * @return the positive shell NFA.
+ * @see Positive(const NFA& one)
+ */
+NFA NFA::makePositive(const NFA& one){
+    NFA result(nullptr, 0, 0, nullptr, 0, 0);
+    result.Positive(one);
+    return result;
+}
+
+/**
+ * @details Builds the positive shell of NFA in its own arrays, so the NFA isn't copied.
+ *
+ * @param one - rvalue reference to an object of type NFA, it's left empty;
+ * @return the positive shell NFA, with a new identifier.
+ * @see closePositive()
+ */
+NFA NFA::makePositive(NFA&& one){
+    NFA result(std::move(one));
+    //the result is a new NFA, so it doesn't keep the identifier of the moved one
+    result.setID(autoCounter++);
+    result.closePositive();
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Builds the reverse NFA.
+ * @details The reverse NFA recognizes the words of the NFA read backwards. Every transition is turned around, the
+ * initial state becomes the only final state and a new initial state with ε-transitions to all the old final states
+ * is added. Its name is one more than the biggest state name.
+ *
+ * @return the reverse NFA, with the same identifier.
+ */
+NFA NFA::reversed() const{
+    NFAIndex index(*this);
+    int statesNum = index.getStatesNum();
+
+    NFA result(nullptr, statesNum + 1, 0, nullptr, currentTransitionsNum + statesNum, 0);
+    result.setID(ID);
+
+    int newInitial = index.nameOf(0);
+    for(int q = 0; q < statesNum; q++){
+        result.addState(State(index.nameOf(q), q == index.getStart()));
+        if(index.nameOf(q) > newInitial)
+            newInitial = index.nameOf(q);
     }
-    return newTo;
+    newInitial++;
+    result.addState(State(newInitial, false));
+    result.setInitialState(State(newInitial, false));
+
+    for(int i = 0; i < currentTransitionsNum; i++)
+        result.addTransition(Transition(transitions[i].to, transitions[i].from, transitions[i].literal));
+    index.getFinals().forEach([&](int q){
+        result.addTransition(Transition(newInitial, index.nameOf(q), '^'));
+    });
+    return result;
 }
 
 /**
- * @brief Checks if the NFA recognizes word.
+ * @brief Removes the states that are useless for the language of the NFA.
+ * @details A state is useful if it can be reached from the initial state and a final state can be reached from it.
+ * Depth-first search from the initial state over the indexed transitions finds the reachable states and depth-first
+ * search from the final states over the reversed transitions finds the co-reachable ones, which takes
+ * O(states + transitions). Then the states and transitions arrays are compacted in place, keeping their order: only
+ * the useful states (and the initial state) and the transitions between two useful states are left. The language of
+ * the NFA doesn't change. The statistics are also kept, so they can be read after a combinator trimmed its result.
  *
- * @param word - the word we are trying to recognize;
- * @return true if the NFA recognizes the word and false otherwise.
- * @see help(int from, char literal, Transition* helpTransitions) const
+ * @return the number of states and transitions before and after trimming.
+ * @see getTrimStats() const
  */
-bool NFA::recognise(char* word){
-    Transition* wordTransitions= new Transition[currentTransitionsNum];
-    for(int i=0;i<=strlen(word); ++i){
-        if(i==0){
-            //if the is no transition from the initial state with the first letter of the word returns false
-            int to = help(initialState.name,word[i],transitions);
-            if(to=='+')
-                return false;
-
-            //sets wordsTransition first element
-            wordTransitions[i].from = initialState.name;
-            wordTransitions[i].to = to;
-            wordTransitions[i].literal = word[i];
-        }
+TrimStats NFA::trim(){
+    TrimStats stats;
+    stats.statesBefore = currentStatesNum;
+    stats.transitionsBefore = currentTransitionsNum;
+    dropEngines();
+
+    NFAIndex index(*this);
+    int statesNum = index.getStatesNum();
+
+    //the reversed transitions, grouped by to-state
+    std::vector<int> reverseOffsets(statesNum + 1, 0), sources(index.getTransitionsNum());
+    for(int i = 0; i < index.getTransitionsNum(); i++)
+        reverseOffsets[index.targetAt(i) + 1]++;
+    for(int q = 0; q < statesNum; q++)
+        reverseOffsets[q + 1] += reverseOffsets[q];
+    std::vector<int> fill(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for(int q = 0; q < statesNum; q++){
+        for(int i = index.begin(q); i < index.end(q); i++)
+            sources[fill[index.targetAt(i)]++] = q;
+    }
 
-        //if we've read the whole word
-        else if(i==strlen(word)){
-            for(int j=0;j<currentStatesNum;j++){
-                //check is the last element of the wordTransitions array is a transition which to-state is final
-                if(wordTransitions[i-1].to == states[j].name && states[j].isFinal)
-                    return true;
+    std::vector<bool> reachable(statesNum, false), coReachable(statesNum, false);
+    std::vector<int> stack(1, index.getStart());
+    reachable[index.getStart()] = true;
+    while(!stack.empty()){
+        int q = stack.back();
+        stack.pop_back();
+        for(int i = index.begin(q); i < index.end(q); i++){
+            if(!reachable[index.targetAt(i)]){
+                reachable[index.targetAt(i)] = true;
+                stack.push_back(index.targetAt(i));
             }
-            return false;
+        }
+    }
 
-        }else{
-            wordTransitions[i].from = wordTransitions[i-1].to;
-            wordTransitions[i].literal = word[i];
-            int tmp = help(wordTransitions[i].from, wordTransitions[i].literal, transitions);
-            if(tmp != 777){
-                wordTransitions[i].to = tmp;
-            }else{
-                int tmp2 = 777;
-                i--;
-                for(int j=0;j<currentTransitionsNum;j++){
-                    if(transitions[j].from == wordTransitions[i].from && wordTransitions[i].literal == transitions[j].literal &&
-                       transitions[j].to != wordTransitions[i].to){
-                        tmp2 = transitions[j].to;
-                        break;
-                    }
-                }
-                if(tmp2 == 777){
-                    return false;
-                }
-                else{
-                    wordTransitions[i].to = tmp2;
-                }
+    index.getFinals().forEach([&](int q){
+        coReachable[q] = true;
+        stack.push_back(q);
+    });
+    while(!stack.empty()){
+        int q = stack.back();
+        stack.pop_back();
+        for(int i = reverseOffsets[q]; i < reverseOffsets[q + 1]; i++){
+            if(!coReachable[sources[i]]){
+                coReachable[sources[i]] = true;
+                stack.push_back(sources[i]);
             }
         }
     }
+
+    int kept = 0;
+    for(int i = 0; i < currentStatesNum; i++){
+        int q = index.indexOf(states[i].name);
+        if((reachable[q] && coReachable[q]) || states[i].name == initialState.name)
+            states[kept++] = states[i];
+    }
+    currentStatesNum = kept;
+
+    kept = 0;
+    for(int i = 0; i < currentTransitionsNum; i++){
+        int from = index.indexOf(transitions[i].from), to = index.indexOf(transitions[i].to);
+        if(reachable[from] && coReachable[from] && reachable[to] && coReachable[to])
+            transitions[kept++] = transitions[i];
+    }
+    currentTransitionsNum = kept;
+
+    stats.statesAfter = currentStatesNum;
+    stats.transitionsAfter = currentTransitionsNum;
+    trimStats = stats;
+    return stats;
 }
 
+/**
+ * @brief Checks if the NFA recognizes word.
+ *
+ * @param word - the NUL-terminated word we are trying to recognize;
+ * @return true if the NFA recognizes the word and false otherwise.
+ * @see recognise(const char* word, size_t length) const
+ */
+bool NFA::recognise(const char* word) const{
+    return recognise(word, strlen(word));
+}
+
+/**
+ * @brief Checks if the NFA recognizes word.
+ * @details Simulates all the paths of the NFA at once, following ε-transitions as well. Small NFA are run by the
+ * bit-parallel engine, the others by the general simulator. The engine is built by the first call and kept until the
+ * NFA changes, so the next words are only run. The engines are published atomically, so NFA that isn't being changed
+ * can be used by several threads.
+ *
+ * @param word - the word we are trying to recognize;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ * @see ShiftAnd
+ * @see Simulator
+ */
+bool NFA::recognise(const char* word, size_t length) const{
+    std::shared_ptr<const ShiftAnd> fast = std::atomic_load(&shiftAnd);
+    if(!fast){
+        fast = std::make_shared<const ShiftAnd>(*this);
+        std::atomic_store(&shiftAnd, fast);
+    }
+    if(fast->isSupported())
+        return fast->recognise(word, length);
+
+    std::shared_ptr<const Simulator> general = std::atomic_load(&simulator);
+    if(!general){
+        general = std::make_shared<const Simulator>(*this);
+        std::atomic_store(&simulator, general);
+    }
+    return general->recognise(word, length);
+}
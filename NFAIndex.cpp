@@ -0,0 +1,182 @@
+/**
+ * @file NFAIndex.cpp
+ * @details Contains the definitions of the indexed (compressed sparse row) layout of the NFA transitions.
+ */
+
+#include<algorithm>
+#include<utility>
+#include"NFAIndex.h"
+#include"BinaryCatalog.h"
+#include"NFA.h"
+
+/**
+ * @details Returns the dense index of a state, giving it a new index if the state hasn't been seen yet.
+ * @param name - the name of the state;
+ * @return the dense index of the state.
+ */
+int NFAIndex::add(int name){
+    std::unordered_map<int, int>::iterator it = denseIndex.find(name);
+    if(it != denseIndex.end())
+        return it->second;
+    denseIndex[name] = statesNum;
+    names.push_back(name);
+    return statesNum++;
+}
+
+/**
+ * @brief Builds the index.
+ * @details Numbers the states densely - first these from the states array (in their order), then the initial state
+ * and the states that appear only in transitions. Then the transitions are bucketed by from-state and every bucket is
+ * sorted by literal. The state is final if it's final in the states array or if it's the initial state and the initial
+ * state is final. Works both with the NFA arrays and with the records of a mapped binary file.
+ *
+ * @param states - the states of the NFA, State or BinaryState;
+ * @param statesCount - number of states;
+ * @param transitions - the transitions of the NFA, Transition or BinaryTransition;
+ * @param transitionsNum - number of transitions;
+ * @param initialState - the initial state of the NFA;
+ */
+template<typename StateRecord, typename TransitionRecord>
+void NFAIndex::build(const StateRecord* states, int statesCount, const TransitionRecord* transitions,
+                     int transitionsNum, const State& initialState){
+    for(int i = 0; i < statesCount; i++)
+        add(states[i].name);
+    start = add(initialState.name);
+
+    //dense from- and to-states of every transition
+    std::vector<int> from(transitionsNum), to(transitionsNum);
+    for(int i = 0; i < transitionsNum; i++){
+        from[i] = add(transitions[i].from);
+        to[i] = add(transitions[i].to);
+    }
+
+    finals.resize(statesNum);
+    for(int i = 0; i < statesCount; i++){
+        if(states[i].isFinal)
+            finals.insert(denseIndex[states[i].name]);
+    }
+    if(initialState.isFinal)
+        finals.insert(start);
+
+    //counting sort of the transitions by from-state
+    offsets.assign(statesNum + 1, 0);
+    for(int i = 0; i < transitionsNum; i++)
+        offsets[from[i] + 1]++;
+    for(int q = 0; q < statesNum; q++)
+        offsets[q + 1] += offsets[q];
+
+    std::vector<std::pair<unsigned char, int> > edges(transitionsNum);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for(int i = 0; i < transitionsNum; i++)
+        edges[fill[from[i]]++] = std::make_pair((unsigned char)transitions[i].literal, to[i]);
+
+    //sorts the transitions of every state by literal
+    literals.resize(transitionsNum);
+    targets.resize(transitionsNum);
+    for(int q = 0; q < statesNum; q++){
+        std::sort(edges.begin() + offsets[q], edges.begin() + offsets[q + 1]);
+        for(int i = offsets[q]; i < offsets[q + 1]; i++){
+            literals[i] = (char)edges[i].first;
+            targets[i] = edges[i].second;
+        }
+    }
+}
+
+/**
+ * @brief Constructor
+ * @param nfa - reference to an object of type NFA;
+ * @see build(const StateRecord* states, int statesCount, const TransitionRecord* transitions, int transitionsNum, const State& initialState)
+ */
+NFAIndex::NFAIndex(const NFA& nfa) : statesNum(0), start(0){
+    build(nfa.getStates(), nfa.getCurrentStatesNum(), nfa.getTransitions(), nfa.getCurrentTransitionsNum(),
+          nfa.getInitialState());
+}
+
+//the records of binary NFA files are indexed by the NFAView constructor in MappedCatalog.cpp
+template void NFAIndex::build(const BinaryState*, int, const BinaryTransition*, int, const State&);
+
+/**
+ * @return the number of dense states.
+ */
+int NFAIndex::getStatesNum() const{
+    return statesNum;
+}
+
+/**
+ * @return the number of transitions.
+ */
+int NFAIndex::getTransitionsNum() const{
+    return int(targets.size());
+}
+
+/**
+ * @return dense index of the initial state.
+ */
+int NFAIndex::getStart() const{
+    return start;
+}
+
+/**
+ * @return the set of final states.
+ */
+const StateSet& NFAIndex::getFinals() const{
+    return finals;
+}
+
+/**
+ * @param name - the name of a state;
+ * @return the dense index of the state or -1 if the NFA has no such state.
+ */
+int NFAIndex::indexOf(int name) const{
+    std::unordered_map<int, int>::const_iterator it = denseIndex.find(name);
+    if(it == denseIndex.end())
+        return -1;
+    return it->second;
+}
+
+/**
+ * @param state - dense index of a state;
+ * @return the name of the state.
+ */
+int NFAIndex::nameOf(int state) const{
+    return names[state];
+}
+
+/**
+ * @param state - dense index of a state;
+ * @return true if the state is final and false otherwise.
+ */
+bool NFAIndex::isFinal(int state) const{
+    return finals.contains(state);
+}
+
+/**
+ * @brief Finds the transitions of a state on a literal.
+ * @details Binary search in the sorted transitions of the state. If there are no such transitions first == last.
+ *
+ * @param state - dense index of the from-state;
+ * @param literal - the literal of the transitions;
+ * @param first - the position of the first transition found;
+ * @param last - the position after the last transition found;
+ */
+void NFAIndex::find(int state, char literal, int& first, int& last) const{
+    unsigned char key = literal;
+    int low = offsets[state], high = offsets[state + 1];
+    while(low < high){
+        int middle = (low + high) / 2;
+        if((unsigned char)literals[middle] < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    first = low;
+    high = offsets[state + 1];
+    while(low < high){
+        int middle = (low + high) / 2;
+        if((unsigned char)literals[middle] <= key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    last = low;
+}
@@ -0,0 +1,88 @@
+/**
+ * \headerfile NFAIndex.h
+ * @details Contains the declaration of the indexed (compressed sparse row) layout of the NFA transitions.
+ */
+
+#ifndef NFA_NFAINDEX_H
+#define NFA_NFAINDEX_H
+
+#include<unordered_map>
+#include<vector>
+#include"StateSet.h"
+
+class NFA;
+struct NFAView;
+struct State;
+
+/**
+ * @class NFAIndex
+ * @brief Compressed sparse row index over the NFA transitions.
+ * @details The state names are mapped to dense indices 0..n-1, so the algorithms can use flat arrays instead of
+ * searching the states array. The transitions are grouped by from-state and sorted by literal (and to-state) inside
+ * every group: the transitions of state q are edges[offsets[q]..offsets[q + 1]) and the transitions of q on a given
+ * literal are found with binary search in O(log k), k being the number of transitions of q.
+ */
+class NFAIndex{
+private:
+    int statesNum;/**< - number of dense states;*/
+    int start;/**< - dense index of the initial state;*/
+    std::unordered_map<int, int> denseIndex;/**< - maps a state name to its dense index;*/
+    std::vector<int> names;/**< - names[q] is the name of the state with dense index q;*/
+    StateSet finals;/**< - the final states;*/
+    std::vector<int> offsets;/**< - the transitions of state q are [offsets[q], offsets[q + 1]);*/
+    std::vector<char> literals;/**< - the literal of every transition;*/
+    std::vector<int> targets;/**< - the dense index of the to-state of every transition;*/
+
+    int add(int name);
+    template<typename StateRecord, typename TransitionRecord>
+    void build(const StateRecord*, int, const TransitionRecord*, int, const State&);
+
+public:
+    explicit NFAIndex(const NFA&);
+    explicit NFAIndex(const NFAView&);
+
+    int getStatesNum() const;
+    int getTransitionsNum() const;
+    int getStart() const;
+    const StateSet& getFinals() const;
+
+    int indexOf(int name) const;
+    int nameOf(int state) const;
+    bool isFinal(int state) const;
+
+    /**
+     * @param state - dense index of a state;
+     * @return the position of the first transition of the state.
+     */
+    int begin(int state) const{
+        return offsets[state];
+    }
+
+    /**
+     * @param state - dense index of a state;
+     * @return the position after the last transition of the state.
+     */
+    int end(int state) const{
+        return offsets[state + 1];
+    }
+
+    /**
+     * @param edge - position of a transition;
+     * @return the literal of the transition.
+     */
+    char literalAt(int edge) const{
+        return literals[edge];
+    }
+
+    /**
+     * @param edge - position of a transition;
+     * @return dense index of the to-state of the transition.
+     */
+    int targetAt(int edge) const{
+        return targets[edge];
+    }
+
+    void find(int state, char literal, int& first, int& last) const;
+};
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file NFASet.cpp
+ * @details Contains the definitions of the set of automata that are matched against a word together.
+ */
+
+#include"NFASet.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+
+/**
+ * @brief Merges the automata into one NFA.
+ * @details The dense state q of the NFA at position p gets the name first[p] + q, where first[p] is the number of
+ * states of the automata before it, and the new initial state gets the name after all of them. The states are added
+ * in the order of their names, so the dense indices of the merged NFA are the names.
+ *
+ * @param nfas - the automata;
+ * @param ids - receives the identifiers of the automata;
+ * @param patternOf - receives the position of the NFA of every final state or -1 for the other states;
+ * @return the merged NFA.
+ */
+NFA NFASet::merge(const std::vector<const NFA*>& nfas, std::vector<int>& ids, std::vector<int>& patternOf){
+    int statesNum = 0, transitionsNum = 0;
+    for(size_t p = 0; p < nfas.size(); p++){
+        statesNum += nfas[p]->getCurrentStatesNum() + 1;
+        transitionsNum += nfas[p]->getCurrentTransitionsNum() + 1;
+    }
+
+    NFA merged(nullptr, statesNum + 1, 0, nullptr, transitionsNum, 0);
+    std::vector<int> starts;
+    int first = 0;
+    for(size_t p = 0; p < nfas.size(); p++){
+        const NFA& nfa = *nfas[p];
+        NFAIndex index(nfa);
+        ids.push_back(nfa.getID());
+
+        for(int q = 0; q < index.getStatesNum(); q++){
+            merged.addState(State(first + q, index.isFinal(q)));
+            patternOf.push_back(index.isFinal(q) ? int(p) : -1);
+        }
+        for(int i = 0; i < nfa.getCurrentTransitionsNum(); i++){
+            const Transition& transition = nfa.getTransitions()[i];
+            merged.addTransition(Transition(first + index.indexOf(transition.from), first + index.indexOf(transition.to),
+                                            transition.literal));
+        }
+        starts.push_back(first + index.getStart());
+        first += index.getStatesNum();
+    }
+
+    merged.addState(State(first, false));
+    patternOf.push_back(-1);
+    merged.setInitialState(State(first, false));
+    for(size_t p = 0; p < starts.size(); p++)
+        merged.addTransition(Transition(first, starts[p], '^'));
+    return merged;
+}
+
+/**
+ * @brief Constructor
+ * @details Merges the automata and builds the simulator of the merged NFA.
+ * @param nfas - pointers to the automata, they aren't used after the set is built;
+ */
+NFASet::NFASet(const std::vector<const NFA*>& nfas) : simulator(merge(nfas, ids, patternOf)){
+}
+
+/**
+ * @return the number of automata in the set.
+ */
+size_t NFASet::size() const{
+    return ids.size();
+}
+
+/**
+ * @param position - position of a NFA in the set, 0..size() - 1;
+ * @return the identifier of the NFA.
+ */
+int NFASet::getID(size_t position) const{
+    return ids[position];
+}
+
+/**
+ * @brief Finds all the automata that recognize word.
+ * @details Simulates the merged NFA once and reads the tags of the final states that are active at the end. The
+ * simulation stops early when no state is active.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @param accepted - receives the identifiers of the automata that recognize the word, in the order of the set;
+ */
+void NFASet::match(const char* word, size_t length, std::vector<int>& accepted) const{
+    accepted.clear();
+    StateSet current(simulator.getStatesNum()), next(simulator.getStatesNum());
+    simulator.startSet(current);
+    for(size_t i = 0; i < length && !current.empty(); i++){
+        simulator.step(current, (unsigned char)word[i], next);
+        current.words.swap(next.words);
+    }
+
+    std::vector<bool> found(ids.size(), false);
+    current.forEach([&](int q){
+        if(patternOf[q] >= 0)
+            found[patternOf[q]] = true;
+    });
+    for(size_t p = 0; p < ids.size(); p++){
+        if(found[p])
+            accepted.push_back(ids[p]);
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * \headerfile NFASet.h
+ * @details Contains the declaration of the set of automata that are matched against a word together.
+ */
+
+#ifndef NFA_NFASET_H
+#define NFA_NFASET_H
+
+#include<cstddef>
+#include<vector>
+#include"Simulator.h"
+
+class NFA;
+
+/**
+ * @class NFASet
+ * @brief Many NFA merged into one automation that tells which of them recognize a word.
+ * @details The states of the automata are renamed so they don't overlap and a new initial state with ε-transitions
+ * to all their initial states is added. Every final state is tagged with the position of the NFA it came from, so one
+ * simulation over the word finds all the NFA that recognize it instead of one pass per NFA.
+ */
+class NFASet{
+private:
+    std::vector<int> ids;/**< - ids[p] is the identifier of the NFA at position p;*/
+    std::vector<int> patternOf;/**< - patternOf[q] is the position of the NFA of final state q or -1;*/
+    Simulator simulator;/**< - the simulator of the merged automation;*/
+
+    static NFA merge(const std::vector<const NFA*>&, std::vector<int>&, std::vector<int>&);
+
+public:
+    explicit NFASet(const std::vector<const NFA*>&);
+
+    size_t size() const;
+    int getID(size_t) const;
+    void match(const char*, size_t, std::vector<int>&) const;
+};
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file ParallelDFA.cpp
+ * @details Contains the definitions of the parallel recognition of one long input with a DFA.
+ */
+
+#include<thread>
+#include<vector>
+#include"ParallelDFA.h"
+#include"DFA.h"
+
+/**
+ * @brief Runs the DFA over a segment from one known state.
+ *
+ * @param dfa - the DFA;
+ * @param state - the state before the segment;
+ * @param text - the segment;
+ * @param length - the number of symbols in the segment;
+ * @return the state after the segment.
+ */
+static uint32_t runFrom(const DFA& dfa, uint32_t state, const unsigned char* text, size_t length){
+    const uint32_t* table = dfa.getTable();
+    const uint8_t* classOf = dfa.getClasses().classOf;
+    uint32_t alphabetSize = dfa.getAlphabetSize();
+    for(size_t i = 0; i < length; i++)
+        state = table[state * alphabetSize + classOf[text[i]]];
+    return state;
+}
+
+/**
+ * @brief Runs the DFA over a segment from every state at once.
+ * @details Every DFA state starts its own path (slot). Every few symbols the paths that reached the same state are
+ * merged - the merged slot points to the slot it was merged into, as in union-find - so only the distinct paths are
+ * advanced. Most DFA forget where they started after a short prefix, then one path is left and the rest of the
+ * segment costs the same as a normal run.
+ *
+ * @param dfa - the DFA;
+ * @param text - the segment;
+ * @param length - the number of symbols in the segment;
+ * @param mapping - receives for every state the state after the segment if we start from it;
+ */
+static void runFromAll(const DFA& dfa, const unsigned char* text, size_t length, std::vector<uint32_t>& mapping){
+    const size_t MERGE_PERIOD = 8;
+    const uint32_t NONE = 0xFFFFFFFF;
+    const uint32_t* table = dfa.getTable();
+    const uint8_t* classOf = dfa.getClasses().classOf;
+    uint32_t alphabetSize = dfa.getAlphabetSize();
+    uint32_t statesNum = dfa.getStatesNum();
+
+    //slot s starts in state s
+    std::vector<uint32_t> state(statesNum), parent(statesNum), active(statesNum), slotIn(statesNum, NONE);
+    for(uint32_t s = 0; s < statesNum; s++){
+        state[s] = s;
+        parent[s] = s;
+        active[s] = s;
+    }
+
+    size_t i = 0;
+    while(i < length && active.size() > 1){
+        size_t end = i + MERGE_PERIOD < length ? i + MERGE_PERIOD : length;
+        for(size_t j = 0; j < active.size(); j++){
+            uint32_t current = state[active[j]];
+            for(size_t k = i; k < end; k++)
+                current = table[current * alphabetSize + classOf[text[k]]];
+            state[active[j]] = current;
+        }
+        i = end;
+
+        //merges the slots that are in the same state
+        size_t kept = 0;
+        for(size_t j = 0; j < active.size(); j++){
+            uint32_t s = active[j];
+            if(slotIn[state[s]] != NONE){
+                parent[s] = slotIn[state[s]];
+            }else{
+                slotIn[state[s]] = s;
+                active[kept++] = s;
+            }
+        }
+        active.resize(kept);
+        for(size_t j = 0; j < active.size(); j++)
+            slotIn[state[active[j]]] = NONE;
+    }
+
+    for(size_t j = 0; j < active.size(); j++)
+        state[active[j]] = runFrom(dfa, state[active[j]], text + i, length - i);
+
+    //every slot ends in the state of the slot it was finally merged into, found with path compression
+    mapping.resize(statesNum);
+    for(uint32_t s = 0; s < statesNum; s++){
+        uint32_t root = s;
+        while(parent[root] != root)
+            root = parent[root];
+        for(uint32_t walk = s; parent[walk] != root;){
+            uint32_t up = parent[walk];
+            parent[walk] = root;
+            walk = up;
+        }
+        mapping[s] = state[root];
+    }
+}
+
+/**
+ * @brief Runs the DFA over a long input on many threads.
+ * @details The input is split into one segment per thread. The first segment is run from the given state and every
+ * other segment is run speculatively from all the DFA states, which gives a state-to-state mapping of the segment.
+ * Composing the mappings in order gives the state after the whole input. With short inputs or one thread the DFA is
+ * run normally. The speedup depends on how fast the paths of a segment merge - DFA that remember a lot about the
+ * input (like counters) keep many paths and gain little.
+ *
+ * @param dfa - the DFA;
+ * @param state - the state before the input;
+ * @param text - the input, not NUL-terminated;
+ * @param length - the number of symbols in the input;
+ * @param threads - number of workers, 0 means one per hardware thread;
+ * @return the state after the input.
+ */
+uint32_t runParallel(const DFA& dfa, uint32_t state, const char* text, size_t length, unsigned threads){
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+    if(threads > length / (PARALLEL_MIN_LENGTH / 2))
+        threads = unsigned(length / (PARALLEL_MIN_LENGTH / 2));
+
+    const unsigned char* input = (const unsigned char*)text;
+    if(threads <= 1 || length < PARALLEL_MIN_LENGTH)
+        return runFrom(dfa, state, input, length);
+
+    std::vector<std::vector<uint32_t> > mappings(threads);
+    uint32_t firstState = state;
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; t++){
+        workers.push_back(std::thread([&, t](){
+            size_t first = length * t / threads, last = length * (t + 1) / threads;
+            if(t == 0)
+                firstState = runFrom(dfa, state, input, last);
+            else
+                runFromAll(dfa, input + first, last - first, mappings[t]);
+        }));
+    }
+    for(size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    uint32_t result = firstState;
+    for(unsigned t = 1; t < threads; t++)
+        result = mappings[t][result];
+    return result;
+}
+
+/**
+ * @brief Checks if the DFA recognizes long word using many threads.
+ *
+ * @param dfa - the DFA;
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @param threads - number of workers, 0 means one per hardware thread;
+ * @return true if the DFA recognizes the word and false otherwise.
+ * @see runParallel(const DFA& dfa, uint32_t state, const char* text, size_t length, unsigned threads)
+ */
+bool recognizeParallel(const DFA& dfa, const char* word, size_t length, unsigned threads){
+    return dfa.isFinal(runParallel(dfa, dfa.getStart(), word, length, threads));
+}
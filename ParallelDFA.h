@@ -0,0 +1,22 @@
+/**
+ * \headerfile ParallelDFA.h
+ * @details Contains the declarations of the parallel recognition of one long input with a DFA.
+ */
+
+#ifndef NFA_PARALLELDFA_H
+#define NFA_PARALLELDFA_H
+
+#include<cstddef>
+#include<cstdint>
+
+class DFA;
+
+/**
+ * @brief Inputs shorter than this are run on one thread - splitting them costs more than it saves.
+ */
+const size_t PARALLEL_MIN_LENGTH = 1 << 20;
+
+uint32_t runParallel(const DFA&, uint32_t, const char*, size_t, unsigned = 0);
+bool recognizeParallel(const DFA&, const char*, size_t, unsigned = 0);
+
+#endif
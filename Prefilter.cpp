@@ -0,0 +1,114 @@
+/**
+ * @file Prefilter.cpp
+ * @details Contains the definitions of the literal prefilter used to skip text that can't start a word of a NFA.
+ */
+
+#include<cstring>
+#include"Prefilter.h"
+#include"NFA.h"
+#include"Simulator.h"
+
+const int Prefilter::MAX_FIRST_BYTES;
+const size_t Prefilter::MAX_PREFIX;
+
+/**
+ * @brief Constructor
+ * @details Starts from the ε-closure of the initial state. The first bytes are the bytes with a transition from it.
+ * While the set of states isn't final and all its transitions read the same byte, that byte is added to the prefix
+ * and the set is advanced on it.
+ *
+ * @param nfa - reference to an object of type NFA;
+ */
+Prefilter::Prefilter(const NFA& nfa) : firstBytesNum(0), usable(false){
+    Simulator simulator(nfa);
+    StateSet current(simulator.getStatesNum()), next(simulator.getStatesNum());
+    simulator.startSet(current);
+
+    for(int c = 0; c < 256; c++){
+        firstBytes[c] = false;
+        if(simulator.usesSymbol((unsigned char)c)){
+            simulator.step(current, (unsigned char)c, next);
+            if(!next.empty()){
+                firstBytes[c] = true;
+                firstBytesNum++;
+            }
+        }
+    }
+
+    if(simulator.isAccepting(current))
+        return;
+
+    while(prefix.size() < MAX_PREFIX && !simulator.isAccepting(current)){
+        int only = -1;
+        for(int c = 0; c < 256 && only != -2; c++){
+            if(!simulator.usesSymbol((unsigned char)c))
+                continue;
+            simulator.step(current, (unsigned char)c, next);
+            if(!next.empty())
+                only = only == -1 ? c : -2;
+        }
+        if(only < 0)
+            break;
+        prefix += char(only);
+        simulator.step(current, (unsigned char)only, next);
+        current.words.swap(next.words);
+    }
+
+    usable = firstBytesNum > 0 && (!prefix.empty() || firstBytesNum <= MAX_FIRST_BYTES);
+}
+
+/**
+ * @return true if the prefilter is selective and can be used and false otherwise.
+ */
+bool Prefilter::isUsable() const{
+    return usable;
+}
+
+/**
+ * @return the prefix every word of the NFA starts with, maybe empty.
+ */
+const std::string& Prefilter::getPrefix() const{
+    return prefix;
+}
+
+/**
+ * @return the number of bytes the words of the NFA can start with.
+ */
+int Prefilter::getFirstBytesNum() const{
+    return firstBytesNum;
+}
+
+/**
+ * @brief Finds the next offset where a word of the NFA may start.
+ * @details With a prefix its occurrences are found with memchr on its first byte and memcmp of the rest. Without a
+ * prefix memchr is run for every first byte and the nearest hit is taken.
+ *
+ * @param text - the text, not NUL-terminated;
+ * @param length - the number of bytes of the text;
+ * @param from - the first offset we check;
+ * @return the first candidate offset not before from or length if there is none.
+ */
+size_t Prefilter::find(const char* text, size_t length, size_t from) const{
+    if(!prefix.empty()){
+        while(from + prefix.size() <= length){
+            const char* hit = (const char*)memchr(text + from, prefix[0], length - from - prefix.size() + 1);
+            if(hit == nullptr)
+                return length;
+            size_t offset = size_t(hit - text);
+            if(memcmp(hit + 1, prefix.data() + 1, prefix.size() - 1) == 0)
+                return offset;
+            from = offset + 1;
+        }
+        return length;
+    }
+
+    size_t best = length;
+    for(int c = 0; c < 256; c++){
+        if(!firstBytes[c] || from >= best)
+            continue;
+        const char* hit = (const char*)memchr(text + from, c, best - from);
+        if(hit != nullptr)
+            best = size_t(hit - text);
+    }
+    return best;
+}
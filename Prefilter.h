@@ -0,0 +1,42 @@
+/**
+ * \headerfile Prefilter.h
+ * @details Contains the declaration of the literal prefilter used to skip text that can't start a word of a NFA.
+ */
+
+#ifndef NFA_PREFILTER_H
+#define NFA_PREFILTER_H
+
+#include<cstddef>
+#include<string>
+
+class NFA;
+
+/**
+ * @class Prefilter
+ * @brief Finds the offsets of a text where a word of a NFA may start.
+ * @details The NFA is analysed once: the required prefix is the longest word that every word of the NFA starts with
+ * and the first bytes are the bytes the words of the NFA can start with. The search then jumps between the
+ * occurrences of the prefix (or of the first byte) with memchr, which is vectorized in the C library, and runs the
+ * automation only there. The prefilter is used only if it's selective - it has a prefix or at most
+ * MAX_FIRST_BYTES first bytes - and the NFA doesn't recognize the empty word.
+ */
+class Prefilter{
+private:
+    std::string prefix;/**< - every word of the NFA starts with prefix;*/
+    bool firstBytes[256];/**< - firstBytes[c] is true if a word of the NFA can start with c;*/
+    int firstBytesNum;/**< - number of the first bytes;*/
+    bool usable;/**< - shows if the prefilter is selective;*/
+
+public:
+    static const int MAX_FIRST_BYTES = 3;/**< - maximum number of first bytes of a selective prefilter;*/
+    static const size_t MAX_PREFIX = 64;/**< - the required prefix is cut to that many bytes;*/
+
+    explicit Prefilter(const NFA&);
+
+    bool isUsable() const;
+    const std::string& getPrefix() const;
+    int getFirstBytesNum() const;
+    size_t find(const char*, size_t, size_t) const;
+};
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file Product.cpp
+ * @details Contains the definitions of the product constructions (intersection and difference) of two NFA.
+ */
+
+#include<unordered_map>
+#include<utility>
+#include<vector>
+#include"Product.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+
+/**
+ * @brief Intersection of two NFA.
+ * @details Product construction on the fly: both NFA are made ε-free and the product states are the pairs (p, q) that
+ * are reachable from the pair of the initial states, numbered 0, 1, ... in the order they are found. The pairs are
+ * numbered through a hash map with key p * (number of states of two) + q. The transitions of p and q are sorted by
+ * literal, so the common literals are found by merging the two lists. A pair is final if both of its states are.
+ *
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @see trim()
+ */
+void NFA::Intersect(const NFA& one, const NFA& two){
+    NFAIndex first(one.removeEpsilon()), second(two.removeEpsilon());
+    uint64_t width = uint64_t(second.getStatesNum());
+
+    std::unordered_map<uint64_t, int> ids;
+    std::vector<std::pair<int, int> > pairs;
+    auto idOf = [&](int p, int q){
+        std::pair<std::unordered_map<uint64_t, int>::iterator, bool> inserted =
+                ids.insert(std::make_pair(uint64_t(p) * width + uint64_t(q), int(pairs.size())));
+        if(inserted.second)
+            pairs.push_back(std::make_pair(p, q));
+        return inserted.first->second;
+    };
+
+    idOf(first.getStart(), second.getStart());
+    for(size_t k = 0; k < pairs.size(); k++){
+        int p = pairs[k].first, q = pairs[k].second;
+        int i = first.begin(p), j = second.begin(q);
+        while(i < first.end(p) && j < second.end(q)){
+            unsigned char literal = first.literalAt(i), other = second.literalAt(j);
+            if(literal < other){
+                i++;
+            }else if(other < literal){
+                j++;
+            }else{
+                //all the pairs of the transitions of p and q on this literal
+                int lastI = i, lastJ = j;
+                while(lastI < first.end(p) && (unsigned char)first.literalAt(lastI) == literal)
+                    lastI++;
+                while(lastJ < second.end(q) && (unsigned char)second.literalAt(lastJ) == literal)
+                    lastJ++;
+                for(int a = i; a < lastI; a++){
+                    for(int b = j; b < lastJ; b++)
+                        addTransition(Transition(int(k), idOf(first.targetAt(a), second.targetAt(b)), char(literal)));
+                }
+                i = lastI;
+                j = lastJ;
+            }
+        }
+    }
+
+    reserve(currentStatesNum + int(pairs.size()), currentTransitionsNum);
+    for(size_t k = 0; k < pairs.size(); k++)
+        addState(State(int(k), first.isFinal(pairs[k].first) && second.isFinal(pairs[k].second)));
+    setInitialState(states[currentStatesNum - int(pairs.size())]);
+    trim();
+}
+
+/**
+ * @brief Difference of two NFA.
+ * @details Product of the ε-free first NFA with the subset construction of the second one, both built on the fly: the
+ * product states are the reachable pairs (p, S) where S is the set of active states of the second NFA, so the second
+ * NFA is determinized only as far as the words of the first one reach. A pair is final if p is final and S isn't.
+ *
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @see trim()
+ */
+void NFA::Difference(const NFA& one, const NFA& two){
+    NFAIndex first(one.removeEpsilon());
+    Simulator second(two);
+
+    //the sets of the second NFA and the memoized steps between them, the key of a step is set * 256 + literal
+    std::unordered_map<StateSet, int, StateSetHash> setIds;
+    std::vector<StateSet> sets;
+    std::unordered_map<uint64_t, int> steps;
+    auto setOf = [&](const StateSet& set){
+        std::pair<std::unordered_map<StateSet, int, StateSetHash>::iterator, bool> inserted =
+                setIds.insert(std::make_pair(set, int(sets.size())));
+        if(inserted.second)
+            sets.push_back(set);
+        return inserted.first->second;
+    };
+
+    std::unordered_map<uint64_t, int> ids;
+    std::vector<std::pair<int, int> > pairs;
+    auto idOf = [&](int p, int s){
+        std::pair<std::unordered_map<uint64_t, int>::iterator, bool> inserted =
+                ids.insert(std::make_pair((uint64_t(p) << 32) | uint64_t(s), int(pairs.size())));
+        if(inserted.second)
+            pairs.push_back(std::make_pair(p, s));
+        return inserted.first->second;
+    };
+
+    StateSet set(second.getStatesNum());
+    second.startSet(set);
+    idOf(first.getStart(), setOf(set));
+    for(size_t k = 0; k < pairs.size(); k++){
+        int p = pairs[k].first, s = pairs[k].second;
+        for(int i = first.begin(p); i < first.end(p); i++){
+            unsigned char literal = first.literalAt(i);
+            uint64_t key = uint64_t(s) * 256 + literal;
+            std::unordered_map<uint64_t, int>::iterator found = steps.find(key);
+            int next;
+            if(found != steps.end()){
+                next = found->second;
+            }else{
+                second.step(sets[s], literal, set);
+                next = setOf(set);
+                steps[key] = next;
+            }
+            addTransition(Transition(int(k), idOf(first.targetAt(i), next), char(literal)));
+        }
+    }
+
+    reserve(currentStatesNum + int(pairs.size()), currentTransitionsNum);
+    for(size_t k = 0; k < pairs.size(); k++)
+        addState(State(int(k), first.isFinal(pairs[k].first) && !second.isAccepting(sets[pairs[k].second])));
+    setInitialState(states[currentStatesNum - int(pairs.size())]);
+    trim();
+}
+
+/**
+ * @details Builds the intersection of two NFA in a new NFA and returns it without copying.
+ *
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @return the intersection NFA.
+ * @see Intersect(const NFA& one, const NFA& two)
+ */
+NFA NFA::makeIntersect(const NFA& one, const NFA& two){
+    NFA result(nullptr, 0, 0, nullptr, 0, 0);
+    result.Intersect(one, two);
+    return result;
+}
+
+/**
+ * @details Builds the difference of two NFA in a new NFA and returns it without copying.
+ *
+ * @param one - reference to an object of type NFA;
+ * @param two - reference to an object of type NFA;
+ * @return the difference NFA.
+ * @see Difference(const NFA& one, const NFA& two)
+ */
+NFA NFA::makeDifference(const NFA& one, const NFA& two){
+    NFA result(nullptr, 0, 0, nullptr, 0, 0);
+    result.Difference(one, two);
+    return result;
+}
+
+/**
+ * @brief Constructor
+ * @param one - reference to the first NFA;
+ * @param two - reference to the second NFA;
+ * @param operation - the operation of the product;
+ */
+ProductMatcher::ProductMatcher(const NFA& one, const NFA& two, ProductOperation operation) : one(one), two(two),
+                                                                                            operation(operation){
+}
+
+/**
+ * @brief Checks if word is in the intersection or the difference of the two NFA.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the product recognizes the word and false otherwise.
+ */
+bool ProductMatcher::recognise(const char* word, size_t length) const{
+    StateSet first(one.getStatesNum()), second(two.getStatesNum());
+    StateSet nextFirst(one.getStatesNum()), nextSecond(two.getStatesNum());
+    one.startSet(first);
+    two.startSet(second);
+    for(size_t i = 0; i < length; i++){
+        unsigned char symbol = word[i];
+        one.step(first, symbol, nextFirst);
+        first.words.swap(nextFirst.words);
+        if(first.empty())
+            return false;
+
+        if(!second.empty()){
+            two.step(second, symbol, nextSecond);
+            second.words.swap(nextSecond.words);
+        }
+        if(operation == INTERSECTION && second.empty())
+            return false;
+    }
+
+    if(operation == INTERSECTION)
+        return one.isAccepting(first) && two.isAccepting(second);
+    return one.isAccepting(first) && !two.isAccepting(second);
+}
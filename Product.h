@@ -0,0 +1,44 @@
+/**
+ * \headerfile Product.h
+ * @details Contains the declaration of the lazy product of two NFA used for intersection and difference membership.
+ */
+
+#ifndef NFA_PRODUCT_H
+#define NFA_PRODUCT_H
+
+#include<cstddef>
+#include"Simulator.h"
+
+class NFA;
+
+/**
+ * @enum ProductOperation
+ * @brief The language operation of a product.
+ */
+enum ProductOperation{
+    INTERSECTION,/**< - the words of both NFA;*/
+    DIFFERENCE/**< - the words of the first NFA that aren't words of the second one;*/
+};
+
+/**
+ * @class ProductMatcher
+ * @brief Checks membership in the intersection or the difference of two NFA without building the product.
+ * @details Both NFA are simulated in lockstep over the word, which visits exactly the product states the word reaches.
+ * The check stops as soon as the answer can't change - when the first NFA has no active state, or, for intersection,
+ * when the second one has none.
+ * @see NFA::Intersect(const NFA& one, const NFA& two)
+ * @see NFA::Difference(const NFA& one, const NFA& two)
+ */
+class ProductMatcher{
+private:
+    Simulator one;/**< - the simulator of the first NFA;*/
+    Simulator two;/**< - the simulator of the second NFA;*/
+    ProductOperation operation;/**< - the operation of the product;*/
+
+public:
+    ProductMatcher(const NFA&, const NFA&, ProductOperation);
+
+    bool recognise(const char*, size_t) const;
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file Search.cpp
+ * @details Contains the definitions of the unanchored search for the words of a NFA in a text.
+ */
+
+#include"Search.h"
+#include"NFA.h"
+
+const size_t Searcher::BLOCK;
+
+/**
+ * @brief Constructor
+ * @details Extracts the prefilter and compiles and minimizes the DFA of the NFA and the unanchored DFA of the reverse
+ * NFA.
+ *
+ * @param nfa - reference to an object of type NFA;
+ * @param maxStates - the maximum number of states of each DFA;
+ * @see isCompiled() const
+ */
+Searcher::Searcher(const NFA& nfa, uint32_t maxStates) : prefilter(nfa){
+    compiled = nfa.compileToDFA(forward, maxStates) && nfa.reversed().compileToDFA(backward, maxStates, true);
+    if(compiled){
+        forward.minimize();
+        backward.minimize();
+    }
+}
+
+/**
+ * @return true if both DFA were built and false if one of them would have more than maxStates states.
+ */
+bool Searcher::isCompiled() const{
+    return compiled;
+}
+
+/**
+ * @brief Finds the offsets of a block where an occurrence starts.
+ * @details Runs the backward DFA from the end of the block to its beginning.
+ *
+ * @param text - the text;
+ * @param first - the first offset of the block;
+ * @param last - the offset after the last byte of the block;
+ * @param state - the state of the backward DFA at offset last;
+ * @param starts - receives bit (i - first) for every offset i in [first, last] where an occurrence starts;
+ */
+void Searcher::findStarts(const unsigned char* text, size_t first, size_t last, uint32_t state,
+                          std::vector<uint64_t>& starts) const{
+    starts.assign((last - first) / 64 + 1, 0);
+    if(backward.isFinal(state))
+        starts[(last - first) >> 6] |= uint64_t(1) << ((last - first) & 63);
+    for(size_t i = last; i > first; i--){
+        state = backward.next(state, text[i - 1]);
+        if(backward.isFinal(state))
+            starts[(i - 1 - first) >> 6] |= uint64_t(1) << ((i - 1 - first) & 63);
+    }
+}
+
+/**
+ * @brief Finds the end of the occurrence that starts at a given offset.
+ * @details Runs the forward DFA until it dies or the text ends.
+ *
+ * @param text - the text;
+ * @param length - the number of bytes of the text;
+ * @param start - the offset where the occurrence should start;
+ * @param kind - which occurrence is reported;
+ * @param end - receives the end of the longest or the shortest occurrence;
+ * @return true if an occurrence starts at start and false otherwise.
+ */
+bool Searcher::findEnd(const unsigned char* text, size_t length, size_t start, MatchKind kind, size_t& end) const{
+    uint32_t state = forward.getStart();
+    bool found = forward.isFinal(state);
+    end = start;
+    if(found && kind == LEFTMOST_SHORTEST)
+        return true;
+
+    for(size_t i = start; i < length && state != DFA::DEAD; i++){
+        state = forward.next(state, text[i]);
+        if(forward.isFinal(state)){
+            found = true;
+            end = i + 1;
+            if(kind == LEFTMOST_SHORTEST)
+                break;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Finds all the non-overlapping occurrences in a text.
+ * @details After an occurrence the search continues from its end; after an empty occurrence it continues from the
+ * next offset. The forward DFA is run only from offsets where the backward DFA proved that an occurrence starts, so
+ * a candidate of the prefilter that doesn't start an occurrence costs nothing.
+ *
+ * @param text - the text, not NUL-terminated;
+ * @param length - the number of bytes of the text;
+ * @param kind - which occurrence is reported when several start at the same offset;
+ * @param matches - receives the occurrences in increasing order;
+ */
+void Searcher::findAll(const char* text, size_t length, MatchKind kind, std::vector<Match>& matches) const{
+    matches.clear();
+    if(!compiled)
+        return;
+
+    const unsigned char* input = (const unsigned char*)text;
+    Match match;
+    size_t blocksNum = length / BLOCK + 1;
+
+    //boundaries[b] is the state of the backward DFA at offset min(b * BLOCK, length)
+    std::vector<uint32_t> boundaries(blocksNum + 1);
+    uint32_t state = backward.getStart();
+    boundaries[blocksNum] = state;
+    for(size_t b = blocksNum; b > 0; b--){
+        size_t first = (b - 1) * BLOCK, last = b * BLOCK < length ? b * BLOCK : length;
+        for(size_t i = last; i > first; i--)
+            state = backward.next(state, input[i - 1]);
+        boundaries[b - 1] = state;
+    }
+
+    std::vector<uint64_t> starts;
+    size_t position = 0;
+    size_t block = blocksNum;
+    while(position <= length){
+        //skips to the next candidate of the prefilter, the NFA doesn't recognize the empty word then, so no occurrence
+        //starts at length
+        if(prefilter.isUsable()){
+            position = prefilter.find(text, length, position);
+            if(position >= length)
+                break;
+        }
+
+        //the block of position and its start offsets
+        if(block != position / BLOCK){
+            block = position / BLOCK;
+            size_t first = block * BLOCK, last = first + BLOCK < length ? first + BLOCK : length;
+            findStarts(input, first, last, boundaries[block + 1], starts);
+        }
+
+        //the first start offset of the block not before position
+        size_t first = block * BLOCK;
+        size_t offset = position - first;
+        size_t word = offset >> 6;
+        uint64_t bits = starts[word] & (~uint64_t(0) << (offset & 63));
+        while(bits == 0 && ++word < starts.size())
+            bits = starts[word];
+        if(bits == 0){
+            position = first + BLOCK;
+            continue;
+        }
+
+        match.start = first + word * 64 + __builtin_ctzll(bits);
+        findEnd(input, length, match.start, kind, match.end);
+        matches.push_back(match);
+        position = match.end > match.start ? match.end : match.start + 1;
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * \headerfile Search.h
+ * @details Contains the declaration of the unanchored search for the words of a NFA in a text.
+ */
+
+#ifndef NFA_SEARCH_H
+#define NFA_SEARCH_H
+
+#include<cstddef>
+#include<cstdint>
+#include<vector>
+#include"DFA.h"
+#include"Prefilter.h"
+
+class NFA;
+
+/**
+ * @struct Match
+ * @brief Occurrence of a word of the NFA in a text.
+ */
+struct Match{
+    size_t start;/**< - offset of the first byte of the occurrence;*/
+    size_t end;/**< - offset after the last byte of the occurrence;*/
+};
+
+/**
+ * @enum MatchKind
+ * @brief Chooses which occurrence is reported when several start at the same offset.
+ * @details The NFA has no order of its alternatives, so there is no leftmost-first occurrence - only the longest and
+ * the shortest occurrence at the leftmost offset.
+ */
+enum MatchKind{
+    LEFTMOST_LONGEST,/**< - the longest occurrence at the leftmost offset;*/
+    LEFTMOST_SHORTEST/**< - the shortest occurrence at the leftmost offset;*/
+};
+
+/**
+ * @class Searcher
+ * @brief Finds all the non-overlapping occurrences of the words of a NFA in a text.
+ * @details Uses two minimized DFA. The unanchored DFA of the reverse NFA is run backwards over the text and is in a
+ * final state exactly at the offsets where an occurrence starts. The DFA of the NFA is then run forwards from the
+ * leftmost start to find the end. Both passes are one table lookup per byte. The backward pass is done in blocks:
+ * the first pass over the whole text keeps only the state at every block boundary, and the start offsets of a block
+ * are recomputed from its boundary state when the forward search reaches it, so the memory used doesn't depend on the
+ * length of the text. If the NFA has a selective prefilter the search jumps from one candidate offset of the
+ * prefilter to the next, so the start offsets are recomputed only for the blocks that have candidates, and the
+ * candidates are still confirmed by the backward DFA - the forward DFA is never run from an offset where no
+ * occurrence starts, which would make the search quadratic.
+ * @see Prefilter
+ */
+class Searcher{
+private:
+    static const size_t BLOCK = 1 << 16;/**< - number of bytes of a block of the backward pass;*/
+
+    DFA forward;/**< - DFA of the NFA;*/
+    DFA backward;/**< - unanchored DFA of the reverse NFA;*/
+    bool compiled;/**< - shows if both DFA were built;*/
+    Prefilter prefilter;/**< - the literal prefilter of the NFA;*/
+
+    void findStarts(const unsigned char*, size_t, size_t, uint32_t, std::vector<uint64_t>&) const;
+    bool findEnd(const unsigned char*, size_t, size_t, MatchKind, size_t&) const;
+
+public:
+    explicit Searcher(const NFA&, uint32_t = DFA::DEFAULT_MAX_STATES);
+
+    bool isCompiled() const;
+    void findAll(const char*, size_t, MatchKind, std::vector<Match>&) const;
+};
+
+#endif
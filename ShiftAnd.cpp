@@ -0,0 +1,173 @@
+/**
+ * @file ShiftAnd.cpp
+ * @details Contains the definitions of the bit-parallel (Shift-And) engine for NFA with up to 256 positions.
+ */
+
+#include<algorithm>
+#include<unordered_map>
+#include"ShiftAnd.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+
+const int ShiftAnd::MAX_POSITIONS;
+
+/**
+ * @brief Constructor
+ * @details Numbers the positions (position 0 is the initial state, then one position for every pair (state, literal)
+ * of a non-ε transition into the state) and builds the masks and the follow tables. The ε-transitions aren't removed
+ * first: the follow set of a position is read from the non-ε transitions of the ε-closure of its state, which is
+ * found with a search over the ε-transitions, so building takes O(positions * (states + transitions)). The positions
+ * are counted before anything else is built, so if there are more than MAX_POSITIONS positions the constructor takes
+ * only O(states + transitions), nothing is built and isSupported() returns false.
+ *
+ * @param nfa - reference to an object of type NFA;
+ */
+ShiftAnd::ShiftAnd(const NFA& nfa) : positionsNum(0), words(0){
+    NFAIndex index(nfa);
+    int statesNum = index.getStatesNum();
+
+    //position of every pair (state, literal), the key is state * 256 + literal
+    std::unordered_map<uint64_t, int> positionOf;
+    std::vector<int> stateOf(1, index.getStart());
+    std::vector<unsigned char> literalOf(1, 0);
+    for(int p = 0; p < statesNum; p++){
+        for(int i = index.begin(p); i < index.end(p); i++){
+            if(index.literalAt(i) == '^')
+                continue;
+            uint64_t key = uint64_t(index.targetAt(i)) * 256 + (unsigned char)index.literalAt(i);
+            if(positionOf.find(key) != positionOf.end())
+                continue;
+            positionOf[key] = int(stateOf.size());
+            stateOf.push_back(index.targetAt(i));
+            literalOf.push_back((unsigned char)index.literalAt(i));
+            if(int(stateOf.size()) > MAX_POSITIONS)
+                return;
+        }
+    }
+
+    positionsNum = int(stateOf.size());
+    words = positionsNum <= 64 ? 1 : positionsNum <= 128 ? 2 : 4;
+
+    symbolMasks.assign(256 * words, 0);
+    finals.assign(words, 0);
+    for(int x = 1; x < positionsNum; x++)
+        symbolMasks[literalOf[x] * words + x / 64] |= uint64_t(1) << (x % 64);
+
+    //follow set of every position - the positions of the non-ε transitions of the ε-closure of its state, the
+    //position is final if the closure has a final state
+    std::vector<uint64_t> follow(positionsNum * words, 0);
+    std::vector<int> visited(statesNum, -1), stack;
+    for(int x = 0; x < positionsNum; x++){
+        bool isFinal = false;
+        visited[stateOf[x]] = x;
+        stack.push_back(stateOf[x]);
+        while(!stack.empty()){
+            int q = stack.back();
+            stack.pop_back();
+            isFinal = isFinal || index.isFinal(q);
+            for(int i = index.begin(q); i < index.end(q); i++){
+                if(index.literalAt(i) == '^'){
+                    if(visited[index.targetAt(i)] != x){
+                        visited[index.targetAt(i)] = x;
+                        stack.push_back(index.targetAt(i));
+                    }
+                    continue;
+                }
+                int y = positionOf[uint64_t(index.targetAt(i)) * 256 + (unsigned char)index.literalAt(i)];
+                follow[x * words + y / 64] |= uint64_t(1) << (y % 64);
+            }
+        }
+        if(isFinal)
+            finals[x / 64] |= uint64_t(1) << (x % 64);
+    }
+
+    //followTable[k][v] is built from followTable[k][v without its lowest bit]
+    int chunks = words * 8;
+    followTable.assign(chunks * 256 * words, 0);
+    for(int k = 0; k < chunks; k++){
+        uint64_t* table = &followTable[k * 256 * words];
+        for(int v = 1; v < 256; v++){
+            int lowest = __builtin_ctz(v);
+            int x = 8 * k + lowest;
+            const uint64_t* rest = &table[(v & (v - 1)) * words];
+            for(int w = 0; w < words; w++)
+                table[v * words + w] = rest[w] | (x < positionsNum ? follow[x * words + w] : 0);
+        }
+    }
+}
+
+/**
+ * @return true if the NFA fits in the engine and false otherwise.
+ */
+bool ShiftAnd::isSupported() const{
+    return positionsNum > 0;
+}
+
+/**
+ * @return the number of positions of the homogeneous NFA, 0 if the NFA is too big.
+ */
+int ShiftAnd::getPositionsNum() const{
+    return positionsNum;
+}
+
+/**
+ * @brief Runs the engine with sets of exactly W words.
+ * @details The set of active positions is kept in a local array of fixed size, so the compiler keeps it in registers
+ * and unrolls (or vectorizes) the word loops.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+template<int W>
+bool ShiftAnd::run(const char* word, size_t length) const{
+    uint64_t active[W] = {1}, next[W];
+    const uint64_t* table = followTable.data();
+    const uint64_t* masks = symbolMasks.data();
+
+    for(size_t i = 0; i < length; i++){
+        for(int w = 0; w < W; w++)
+            next[w] = 0;
+        for(int w = 0; w < W; w++){
+            uint64_t bits = active[w];
+            for(int b = 0; b < 8; b++){
+                const uint64_t* chunk = table + ((w * 8 + b) * 256 + ((bits >> (8 * b)) & 0xFF)) * W;
+                for(int v = 0; v < W; v++)
+                    next[v] |= chunk[v];
+            }
+        }
+
+        const uint64_t* mask = masks + (unsigned char)word[i] * W;
+        uint64_t any = 0;
+        for(int w = 0; w < W; w++){
+            active[w] = next[w] & mask[w];
+            any |= active[w];
+        }
+        if(any == 0)
+            return false;
+    }
+
+    uint64_t accepted = 0;
+    for(int w = 0; w < W; w++)
+        accepted |= active[w] & finals[w];
+    return accepted != 0;
+}
+
+/**
+ * @brief Checks if the NFA recognizes word.
+ * @details Must be called only if isSupported() returns true.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+bool ShiftAnd::recognise(const char* word, size_t length) const{
+    switch(words){
+        case 1:
+            return run<1>(word, length);
+        case 2:
+            return run<2>(word, length);
+        default:
+            return run<4>(word, length);
+    }
+}
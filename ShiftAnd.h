@@ -0,0 +1,51 @@
+/**
+ * \headerfile ShiftAnd.h
+ * @details Contains the declaration of the bit-parallel (Shift-And) engine for NFA with up to 256 positions.
+ */
+
+#ifndef NFA_SHIFTAND_H
+#define NFA_SHIFTAND_H
+
+#include<cstddef>
+#include<cstdint>
+#include<vector>
+
+class NFA;
+
+/**
+ * @class ShiftAnd
+ * @brief Bit-parallel simulation of small NFA in fixed-size machine words.
+ * @details The NFA is made homogeneous - every state is split into one position for every literal it is entered with
+ * by a non-ε transition (Glushkov positions), plus one position for the initial state, and the ε-transitions are
+ * folded into the follow sets. Then all the transitions into a position read the same byte and one step on byte c is
+ *
+ *      active = follow(active) & symbolMask[c]
+ *
+ * where follow(active) is the union of the positions reachable from the active ones and doesn't depend on c. It's
+ * read from precomputed tables, one table of 256 masks for every 8 positions, so a step is a few lookups and word
+ * operations with no branches. The set of active positions is 1, 2 or 4 64-bit words, chosen by the number of
+ * positions; NFA with more than MAX_POSITIONS positions aren't supported.
+ * @see isSupported() const
+ */
+class ShiftAnd{
+private:
+    int positionsNum;/**< - number of positions, 0 if the NFA is too big;*/
+    int words;/**< - number of 64-bit words of a set of positions, 1, 2 or 4;*/
+    std::vector<uint64_t> symbolMasks;/**< - symbolMasks[c * words..] are the positions entered with byte c;*/
+    std::vector<uint64_t> followTable;/**< - followTable[((k * 256) + v) * words..] is the follow set of the positions 8k + i for every bit i of v;*/
+    std::vector<uint64_t> finals;/**< - the final positions;*/
+
+    template<int W>
+    bool run(const char*, size_t) const;
+
+public:
+    static const int MAX_POSITIONS = 256;/**< - maximum number of positions the engine supports;*/
+
+    explicit ShiftAnd(const NFA&);
+
+    bool isSupported() const;
+    int getPositionsNum() const;
+    bool recognise(const char*, size_t) const;
+};
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file Simulator.cpp
+ * @details Contains the definitions of the bit-parallel NFA simulation engine.
+ */
+
+#include<algorithm>
+#include<cstdint>
+#include<unordered_map>
+#include"Simulator.h"
+#include"NFA.h"
+#include"NFAIndex.h"
+
+/**
+ * @param index - reference to an object of type NFAIndex;
+ * @param state - dense index of a state;
+ * @param edge - position of a transition of the state;
+ * @return true if the transition before it is the same transition and false otherwise.
+ */
+static bool repeats(const NFAIndex& index, int state, int edge){
+    return edge > index.begin(state) && index.literalAt(edge - 1) == index.literalAt(edge) &&
+           index.targetAt(edge - 1) == index.targetAt(edge);
+}
+
+/**
+ * @brief Constructor
+ * @details Groups the transitions of the indexed NFA by literal and computes the ε-closures of the states. The index
+ * sorts the transitions of every state by literal and to-state, so a repeated transition is next to its copy and is
+ * left out.
+ * @see EpsilonClosure
+ *
+ * @param index - reference to an object of type NFAIndex;
+ */
+Simulator::Simulator(const NFAIndex& index) : statesNum(index.getStatesNum()), start(index.getStart()),
+                                              finals(index.getFinals()), closure(index){
+    //counting sort of the non-ε transitions by literal
+    symbolOffsets.assign(257, 0);
+    for(int q = 0; q < statesNum; q++){
+        for(int i = index.begin(q); i < index.end(q); i++){
+            if(index.literalAt(i) != '^' && !repeats(index, q, i))
+                symbolOffsets[(unsigned char)index.literalAt(i) + 1]++;
+        }
+    }
+    for(int c = 0; c < 256; c++)
+        symbolOffsets[c + 1] += symbolOffsets[c];
+
+    symbolEdges.resize(symbolOffsets[256]);
+    std::vector<int> fill(symbolOffsets.begin(), symbolOffsets.end() - 1);
+    for(int q = 0; q < statesNum; q++){
+        for(int i = index.begin(q); i < index.end(q); i++){
+            if(index.literalAt(i) != '^' && !repeats(index, q, i))
+                symbolEdges[fill[(unsigned char)index.literalAt(i)]++] = std::make_pair(q, index.targetAt(i));
+        }
+    }
+}
+
+/**
+ * @brief Constructor
+ * @details Indexes the NFA and builds the simulator from the index.
+ * @param nfa - reference to an object of type NFA;
+ * @see Simulator(const NFAIndex& index)
+ */
+Simulator::Simulator(const NFA& nfa) : Simulator(NFAIndex(nfa)){
+}
+
+/**
+ * @return the number of dense states of the simulated NFA.
+ */
+int Simulator::getStatesNum() const{
+    return statesNum;
+}
+
+/**
+ * @param symbol - the symbol we are looking for;
+ * @return true if at least one transition of the NFA reads symbol and false otherwise.
+ */
+bool Simulator::usesSymbol(unsigned char symbol) const{
+    return symbolOffsets[symbol] != symbolOffsets[symbol + 1];
+}
+
+/**
+ * @brief Partitions the bytes into classes of bytes the NFA can't tell apart.
+ * @details Two bytes are in the same class if their (from, to) pairs are the same. The pairs of every byte are sorted
+ * and without repetitions, so the bytes are grouped by a hash of their pairs and the pairs are compared only inside a
+ * group. Takes O(T) for T transitions.
+ *
+ * @return the byte classes.
+ * @see ByteClasses
+ */
+ByteClasses Simulator::getClasses() const{
+    uint8_t same[256];
+    std::unordered_map<uint64_t, std::vector<int> > groups;
+    for(int c = 0; c < 256; c++){
+        uint64_t hash = 14695981039346656037ULL;
+        for(int i = symbolOffsets[c]; i < symbolOffsets[c + 1]; i++){
+            hash = (hash ^ uint64_t(symbolEdges[i].first)) * 1099511628211ULL;
+            hash = (hash ^ uint64_t(symbolEdges[i].second)) * 1099511628211ULL;
+        }
+
+        std::vector<int>& group = groups[hash];
+        same[c] = uint8_t(c);
+        for(size_t j = 0; j < group.size() && same[c] == c; j++){
+            int other = group[j];
+            if(symbolOffsets[c + 1] - symbolOffsets[c] == symbolOffsets[other + 1] - symbolOffsets[other] &&
+               std::equal(symbolEdges.begin() + symbolOffsets[c], symbolEdges.begin() + symbolOffsets[c + 1],
+                          symbolEdges.begin() + symbolOffsets[other]))
+                same[c] = uint8_t(other);
+        }
+        if(same[c] == c)
+            group.push_back(c);
+    }
+
+    ByteClasses classes;
+    classes.build(same);
+    return classes;
+}
+
+/**
+ * @details Sets result to the ε-closure of the initial state.
+ * @param result - reference to an object of type StateSet;
+ */
+void Simulator::startSet(StateSet& result) const{
+    result = closure.of(start);
+}
+
+/**
+ * @brief Advances all the active states on one symbol.
+ * @details Result becomes the ε-closure of all the states reachable from current with one transition on symbol.
+ *
+ * @param current - the active states before reading the symbol;
+ * @param symbol - the symbol we read;
+ * @param result - the active states after reading the symbol;
+ */
+void Simulator::step(const StateSet& current, unsigned char symbol, StateSet& result) const{
+    result.clear();
+    for(int i = symbolOffsets[symbol]; i < symbolOffsets[symbol + 1]; i++){
+        const std::pair<int, int>& edge = symbolEdges[i];
+        if(current.contains(edge.first) && !result.contains(edge.second))
+            result.unite(closure.of(edge.second));
+    }
+}
+
+/**
+ * @param set - reference to an object of type StateSet;
+ * @return true if the set contains a final state and false otherwise.
+ */
+bool Simulator::isAccepting(const StateSet& set) const{
+    return set.intersects(finals);
+}
+
+/**
+ * @brief Checks if the NFA recognizes word.
+ * @details Stops as soon as there are no active states left.
+ *
+ * @param word - the word we are trying to recognize, it doesn't need to be NUL-terminated;
+ * @param length - the number of symbols in the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+bool Simulator::recognise(const char* word, size_t length) const{
+    StateSet current(statesNum), next(statesNum);
+    startSet(current);
+    for(size_t i = 0; i < length; i++){
+        step(current, (unsigned char)word[i], next);
+        current.words.swap(next.words);
+        if(current.empty())
+            return false;
+    }
+    return isAccepting(current);
+}
@@ -0,0 +1,49 @@
+/**
+ * \headerfile Simulator.h
+ * @details Contains the declaration of the bit-parallel NFA simulation engine.
+ */
+
+#ifndef NFA_SIMULATOR_H
+#define NFA_SIMULATOR_H
+
+#include<cstddef>
+#include<utility>
+#include<vector>
+#include"ByteClasses.h"
+#include"EpsilonClosure.h"
+#include"StateSet.h"
+
+class NFA;
+class NFAIndex;
+
+/**
+ * @class Simulator
+ * @brief Thompson-style simulation of a NFA.
+ * @details Keeps all the active states of the NFA in a StateSet and advances them together on every input symbol, so
+ * nondeterminism and ε-transitions never need backtracking. The simulator works on the dense state indices of
+ * NFAIndex.
+ * @see NFAIndex
+ */
+class Simulator{
+private:
+    int statesNum;/**< - number of dense states;*/
+    int start;/**< - dense index of the initial state;*/
+    StateSet finals;/**< - the final states;*/
+    EpsilonClosure closure;/**< - the ε-closures of the states;*/
+    std::vector<int> symbolOffsets;/**< - symbolEdges[symbolOffsets[c]..symbolOffsets[c + 1]) are the edges on byte c;*/
+    std::vector<std::pair<int, int> > symbolEdges;/**< - sorted (from, to) dense pairs of the non-ε transitions of every byte;*/
+
+public:
+    explicit Simulator(const NFAIndex&);
+    explicit Simulator(const NFA&);
+
+    int getStatesNum() const;
+    bool usesSymbol(unsigned char) const;
+    ByteClasses getClasses() const;
+    void startSet(StateSet&) const;
+    void step(const StateSet&, unsigned char, StateSet&) const;
+    bool isAccepting(const StateSet&) const;
+    bool recognise(const char*, size_t) const;
+};
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * \headerfile StateSet.h
+ * @details Contains the StateSet declaration - a dense bitset of NFA states used by the recognition engines.
+ */
+
+#ifndef NFA_STATESET_H
+#define NFA_STATESET_H
+
+#include<cstddef>
+#include<cstdint>
+#include<vector>
+
+/**
+ * @struct StateSet
+ * @brief Dense set of NFA states.
+ * @details Every state is identified by its dense index (0..n-1) and takes one bit, so union, intersection and
+ * comparison of two sets cost O(n / 64) word operations.
+ */
+struct StateSet{
+    std::vector<uint64_t> words;/**< - the bits of the set, 64 states per word;*/
+
+    /**
+     * @brief Default constructor
+     * @param size - the number of states the set can hold, 0 by default;
+     */
+    explicit StateSet(int size = 0) : words((size + 63) / 64, 0){}
+
+    /**
+     * @details Changes the number of states the set can hold and clears it.
+     * @param size - the new number of states;
+     */
+    void resize(int size){
+        words.assign((size + 63) / 64, 0);
+    }
+
+    /**
+     * @brief Removes all the states from the set.
+     */
+    void clear(){
+        for(size_t i = 0; i < words.size(); i++)
+            words[i] = 0;
+    }
+
+    /**
+     * @param state - dense index of the state we add;
+     */
+    void insert(int state){
+        words[state >> 6] |= uint64_t(1) << (state & 63);
+    }
+
+    /**
+     * @param state - dense index of the state we are looking for;
+     * @return true if the state is in the set and false otherwise.
+     */
+    bool contains(int state) const{
+        return (words[state >> 6] >> (state & 63)) & 1;
+    }
+
+    /**
+     * @details Adds all the states of other to the set. Both sets must hold the same number of states.
+     * @param other - reference to an object of type StateSet;
+     */
+    void unite(const StateSet& other){
+        for(size_t i = 0; i < words.size(); i++)
+            words[i] |= other.words[i];
+    }
+
+    /**
+     * @param other - reference to an object of type StateSet of the same size;
+     * @return true if the two sets have at least one common state and false otherwise.
+     */
+    bool intersects(const StateSet& other) const{
+        for(size_t i = 0; i < words.size(); i++){
+            if(words[i] & other.words[i])
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @param other - reference to an object of type StateSet of the same size;
+     * @return true if every state of the set is in other and false otherwise.
+     */
+    bool isSubsetOf(const StateSet& other) const{
+        for(size_t i = 0; i < words.size(); i++){
+            if(words[i] & ~other.words[i])
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @return true if there are no states in the set and false otherwise.
+     */
+    bool empty() const{
+        for(size_t i = 0; i < words.size(); i++){
+            if(words[i])
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @details Calls f with the dense index of every state in the set in increasing order.
+     * @param f - function object taking int;
+     */
+    template<typename Function>
+    void forEach(Function f) const{
+        for(size_t i = 0; i < words.size(); i++){
+            uint64_t word = words[i];
+            while(word){
+                f(int(i * 64 + __builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    bool operator==(const StateSet& other) const{
+        return words == other.words;
+    }
+
+    bool operator!=(const StateSet& other) const{
+        return words != other.words;
+    }
+};
+
+/**
+ * @struct StateSetHash
+ * @brief Hash function object that lets StateSet be used as a key of unordered containers.
+ */
+struct StateSetHash{
+    size_t operator()(const StateSet& set) const{
+        uint64_t hash = 14695981039346656037ULL;
+        for(size_t i = 0; i < set.words.size(); i++){
+            hash ^= set.words[i];
+            hash *= 1099511628211ULL;
+            hash ^= hash >> 29;
+        }
+        return size_t(hash);
+    }
+};
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file StreamMatcher.cpp
+ * @details Contains the definitions of the streaming recognizer that reads its input in chunks.
+ */
+
+#include"StreamMatcher.h"
+#include"DFA.h"
+#include"ParallelDFA.h"
+#include"Simulator.h"
+
+/**
+ * @brief Constructor
+ * @details Creates matcher that walks the DFA table.
+ * @param dfa - reference to an object of type DFA;
+ */
+StreamMatcher::StreamMatcher(const DFA& dfa) : dfa(&dfa), simulator(nullptr){
+    reset();
+}
+
+/**
+ * @brief Constructor
+ * @details Creates matcher that simulates the NFA, used when the NFA can't be compiled to DFA.
+ * @param simulator - reference to an object of type Simulator;
+ */
+StreamMatcher::StreamMatcher(const Simulator& simulator) : dfa(nullptr), simulator(&simulator),
+                                                           current(simulator.getStatesNum()),
+                                                           next(simulator.getStatesNum()){
+    reset();
+}
+
+/**
+ * @brief Starts a new word.
+ */
+void StreamMatcher::reset(){
+    consumed = 0;
+    if(dfa != nullptr)
+        state = dfa->getStart();
+    else
+        simulator->startSet(current);
+}
+
+/**
+ * @brief Reads the next chunk of the word.
+ * @details Once no state is active the rest of the input is only counted. Long chunks are split between all the
+ * cores when there is a DFA.
+ *
+ * @param chunk - the next symbols of the word, not NUL-terminated;
+ * @param length - the number of symbols in the chunk;
+ */
+void StreamMatcher::feed(const char* chunk, size_t length){
+    consumed += length;
+    if(isDead())
+        return;
+
+    if(dfa != nullptr && length >= PARALLEL_MIN_LENGTH){
+        state = runParallel(*dfa, state, chunk, length);
+        return;
+    }
+
+    if(dfa != nullptr){
+        uint32_t current = state;
+        for(size_t i = 0; i < length; i++)
+            current = dfa->next(current, (unsigned char)chunk[i]);
+        state = current;
+        return;
+    }
+
+    for(size_t i = 0; i < length; i++){
+        simulator->step(current, (unsigned char)chunk[i], next);
+        current.words.swap(next.words);
+        if(current.empty())
+            return;
+    }
+}
+
+/**
+ * @return true if no continuation of the input fed so far can be recognized and false otherwise.
+ */
+bool StreamMatcher::isDead() const{
+    if(dfa != nullptr)
+        return state == DFA::DEAD;
+    return current.empty();
+}
+
+/**
+ * @details Can be called many times; feeding can continue after it.
+ * @return true if the input fed since the last reset() is recognized and false otherwise.
+ */
+bool StreamMatcher::finish() const{
+    if(dfa != nullptr)
+        return dfa->isFinal(state);
+    return simulator->isAccepting(current);
+}
+
+/**
+ * @return the number of bytes fed since the last reset().
+ */
+uint64_t StreamMatcher::getConsumed() const{
+    return consumed;
+}
@@ -0,0 +1,43 @@
+/**
+ * \headerfile StreamMatcher.h
+ * @details Contains the declaration of the streaming recognizer that reads its input in chunks.
+ */
+
+#ifndef NFA_STREAMMATCHER_H
+#define NFA_STREAMMATCHER_H
+
+#include<cstddef>
+#include<cstdint>
+#include"StateSet.h"
+
+class DFA;
+class Simulator;
+
+/**
+ * @class StreamMatcher
+ * @brief Recognizes word that is given in chunks of any size.
+ * @details Only the current DFA state (or the current set of NFA states) is kept between the chunks, so the memory
+ * used doesn't depend on the length of the word. The word may contain NUL bytes. The automation must live as long as
+ * the matcher.
+ */
+class StreamMatcher{
+private:
+    const DFA* dfa;/**< - the DFA we use or nullptr;*/
+    const Simulator* simulator;/**< - the simulator we use if there is no DFA;*/
+    uint32_t state;/**< - the current DFA state;*/
+    StateSet current;/**< - the current NFA states;*/
+    StateSet next;/**< - buffer for the next NFA states;*/
+    uint64_t consumed;/**< - number of bytes fed so far;*/
+
+public:
+    explicit StreamMatcher(const DFA&);
+    explicit StreamMatcher(const Simulator&);
+
+    void reset();
+    void feed(const char*, size_t);
+    bool isDead() const;
+    bool finish() const;
+    uint64_t getConsumed() const;
+};
+
+#endif
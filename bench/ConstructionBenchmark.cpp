@@ -0,0 +1,77 @@
+/**
+ * @file ConstructionBenchmark.cpp
+ * @details Measures how long it takes to build NFA with many transitions. Compares the old grow-by-one strategy of
+ * addTransition, the current geometric growth and building after reserve().
+ */
+
+#include<chrono>
+#include<iostream>
+#include<iomanip>
+#include"../NFA.h"
+
+/**
+ * @details Appends n transitions to an array that grows by exactly one element - the strategy addTransition used before
+ * the geometric growth.
+ * @param n - the number of transitions;
+ * @return the elapsed time in milliseconds.
+ */
+double growByOne(int n){
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    int current = 0, max = 10;
+    Transition* transitions = new Transition[max];
+    for(int i = 0; i < n; i++){
+        if(current == max){
+            ++max;
+            Transition* buffer = new Transition[max];
+            for(int j = 0; j < current; j++)
+                buffer[j] = transitions[j];
+            delete[] transitions;
+            transitions = buffer;
+        }
+        transitions[current++] = Transition(i, i + 1, 'a');
+    }
+    delete[] transitions;
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @details Builds NFA with n states and n transitions with addState and addTransition.
+ * @param n - the number of states and transitions;
+ * @param reserved - if true reserve() is called before adding;
+ * @return the elapsed time in milliseconds.
+ */
+double build(int n, bool reserved){
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    NFA nfa;
+    if(reserved)
+        nfa.reserve(n, n);
+    for(int i = 0; i < n; i++){
+        nfa.addState(State(i, false));
+        nfa.addTransition(Transition(i, i + 1, 'a'));
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @details Prints one row for every size - the old strategy is measured only up to 32000 transitions because it's
+ * quadratic.
+ * @return - 0 - a success status.
+ */
+int main(){
+    std::cout<<std::setw(10)<<"n"<<std::setw(16)<<"grow-by-one ms"<<std::setw(16)<<"geometric ms"
+             <<std::setw(16)<<"reserve ms"<<std::endl;
+
+    for(int n = 1000; n <= 1024000; n *= 2){
+        std::cout<<std::setw(10)<<n;
+        if(n <= 32000)
+            std::cout<<std::setw(16)<<std::fixed<<std::setprecision(2)<<growByOne(n);
+        else
+            std::cout<<std::setw(16)<<"-";
+        std::cout<<std::setw(16)<<build(n, false)<<std::setw(16)<<build(n, true)<<std::endl;
+    }
+    return 0;
+}
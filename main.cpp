@@ -7,7 +7,64 @@
 #include<cstdio>
 #include<sstream>
 #include<fstream>
+#include<memory>
+#include<vector>
 #include"NFA.h"
+#include"AutomatonCache.h"
+#include"Batch.h"
+#include"BinaryCatalog.h"
+#include"NFASet.h"
+#include"Product.h"
+#include"Search.h"
+#include"Simulator.h"
+#include"StreamMatcher.h"
+
+/**
+ * @details Prints how many states and transitions were left by trimming.
+ * @param stats - the statistics of the trimming;
+ * @see NFA::trim()
+ */
+static void printTrimStats(const TrimStats& stats){
+    std::cout<<"States: "<<stats.statesBefore<<" -> "<<stats.statesAfter<<", transitions: "
+             <<stats.transitionsBefore<<" -> "<<stats.transitionsAfter<<std::endl;
+}
+
+/**
+ * @details Appends the automata of the binary file attached to the session to the temporary file and detaches the
+ * binary file, so the temporary file has all the automata of the session again. Called before the temporary file is
+ * saved or exported.
+ *
+ * @param cache - the cache of the session;
+ * @param fileTemp - the temporary file;
+ */
+static void appendAttached(AutomatonCache& cache, std::fstream& fileTemp){
+    if(!cache.isAttached())
+        return;
+    fileTemp.flush();
+    if(!BinaryCatalog::convertBinaryToText(cache.getAttachedName(), "temp.txt"))
+        std::cout<<"Couldn't import file!"<<std::endl;
+    cache.detach();
+}
+
+/**
+ * @details Reads a whole file into one buffer of its size, without any intermediate copy.
+ *
+ * @param name - the name of the file;
+ * @param content - receives the bytes of the file;
+ * @return true if the file was read and false otherwise.
+ */
+static bool readContent(const std::string& name, std::vector<char>& content){
+    std::ifstream file(name, std::ios::in | std::ios::binary);
+    if(!file)
+        return false;
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if(size < 0)
+        return false;
+    file.seekg(0, std::ios::beg);
+    content.resize(size_t(size));
+    return content.empty() || bool(file.read(content.data(), size));
+}
 
 /**
  * @details Gives the users the chance to operate with NFAs. Some of the operations supported are: union/concatenation
@@ -59,6 +116,8 @@ int main() {
 
             std::cout<<std::endl;
             std::string specialInput, specialWord;
+            //parsed and compiled automata of the file, so that repeated commands on the same NFA don't read it again
+            AutomatonCache cache;
             //while file is opened user can make some operations on it by entering commands
             while(getline(std::cin, specialInput)){
                 //stores the input in another stream and reads the first word of it
@@ -77,12 +136,15 @@ int main() {
                         if(line[0] == '<')
                             std::cout<<line<<std::endl;
                     }
+                    for(int i = 0; i < cache.getAttachedNum(); i++)
+                        std::cout<<"< "<<cache.getAttachedID(i)<<" >"<<std::endl;
                     std::cout<<std::endl;
                 }
 
                 //if the user input is "save" - saves the changes to the file that user inputed by reading the temporary
                 //file line by line and writing it in the inputed file
                 if(specialWord == "save"){
+                    appendAttached(cache, fileTemp);
                     file.close();
                     fileTemp.clear();
                     fileTemp.seekp(0, std::ios::beg);
@@ -100,6 +162,7 @@ int main() {
 
                     std::remove("temp.txt");
                     file.close();
+                    cache.invalidate();
 
                     std::cout<<"File saved!"<<std::endl;
                     std::cout<<std::endl;
@@ -108,6 +171,7 @@ int main() {
 
                 //if the user input is "saveAs" - saves the changes to a new file which name the user inputs
                 if(specialWord == "saveAs"){
+                    appendAttached(cache, fileTemp);
                     fileTemp.clear();
                     fileTemp.seekg(0, std::ios::beg);
                     specialStream>>specialWord;
@@ -145,6 +209,7 @@ int main() {
                     NFA nfa;
                     nfa.input();
                     nfa.writeToFile("temp.txt");
+                    cache.invalidate();
                     std::cin.ignore();
                     std::cout<<"NFA successfully added!"<<std::endl;
                     std::cout<<std::endl;
@@ -154,80 +219,179 @@ int main() {
                 if(specialWord == "print"){
                     int found;
                     specialStream>>found;
-                    NFA nfa;
-                    nfa.setID(found);
-                    nfa.readFromFile(found);
-                    nfa.print();
+                    cache.get(found).print();
                 }
 
                 //if the user input is "union" - gets the two identifiers that the user inputed, finds the NFAs with this
-                //identifiers in the file and makes their union, then prints the result
+                //identifiers in the file and makes their union, then prints how much trimming
+                //removed and the result
                 if(specialWord == "union"){
                     int id1, id2;
                     specialStream>>id1;
                     specialStream>>id2;
 
-                    NFA one, two, three;
-                    one.readFromFile(id1);
-                    two.readFromFile(id2);
-
-                    three.Union(one, two);
+                    NFA three = NFA::makeUnion(cache.get(id1), cache.get(id2));
+                    printTrimStats(three.getTrimStats());
                     three.print();
                 }
 
                 //if the user input is "concatenation" - gets the two identifiers that the user inputed finds the NFAs with this
-                //identifiers in the file and makes their concatenation, then prints the result
+                //identifiers in the file and makes their concatenation, then prints how much
+                //trimming removed and the result
                 if(specialWord == "concatenation"){
                     int id1, id2;
                     specialStream>>id1;
                     specialStream>>id2;
 
-                    NFA one, two, three;
-                    one.readFromFile(id1);
-                    two.readFromFile(id2);
-
-                    three.Concat(one, two);
+                    NFA three = NFA::makeConcat(cache.get(id1), cache.get(id2));
+                    printTrimStats(three.getTrimStats());
                     three.print();
                 }
 
                 //if the user input is "positive" - gets the identifier that the user inputed, finds the NFA with this
-                //identifier in the file and makes its positive shell, then prints the result
+                //identifier in the file and makes its positive shell, then prints how much
+                //trimming removed and the result
                 if(specialWord == "positive"){
                     int id1;
                     specialStream>>id1;
 
-                    NFA one, two;
-                    one.readFromFile(id1);
-                    two.Positive(one);
+                    NFA two = NFA::makePositive(cache.get(id1));
+                    printTrimStats(two.getTrimStats());
                     two.print();
                 }
 
+                //if the user input is "intersect" - gets the two identifiers that the user inputed, finds the NFAs with
+                //this identifiers in the file and makes their intersection, then prints how much
+                //trimming removed and the result
+                if(specialWord == "intersect"){
+                    int id1, id2;
+                    specialStream>>id1;
+                    specialStream>>id2;
+
+                    NFA three = NFA::makeIntersect(cache.get(id1), cache.get(id2));
+                    printTrimStats(three.getTrimStats());
+                    three.print();
+                }
+
+                //if the user input is "difference" - gets the two identifiers that the user inputed, finds the NFAs with
+                //this identifiers in the file and makes the NFA of the words of the first one that aren't words of the
+                //second one, then prints how much trimming removed and the result
+                if(specialWord == "difference"){
+                    int id1, id2;
+                    specialStream>>id1;
+                    specialStream>>id2;
+
+                    NFA three = NFA::makeDifference(cache.get(id1), cache.get(id2));
+                    printTrimStats(three.getTrimStats());
+                    three.print();
+                }
+
+                //if the user input is "recognizeDifference" - gets the two identifiers and the word that the user
+                //inputed and checks if the first NFA recognizes the word and the second one doesn't, without building
+                //the difference NFA
+                if(specialWord == "recognizeDifference"){
+                    int id1, id2;
+                    std::string word;
+                    specialStream>>id1>>id2>>word;
+
+                    ProductMatcher matcher(cache.get(id1), cache.get(id2), DIFFERENCE);
+                    if(matcher.recognise(word.data(), word.size()))
+                        std::cout<<"Yes"<<std::endl;
+                    else
+                        std::cout<<"No"<<std::endl;
+                    std::cout<<std::endl;
+                }
+
+                //if the user input is "equivalent" - gets the two identifiers that the user inputed and checks if the
+                //two NFAs recognize the same language; if not, prints a word that only one of them recognizes
+                if(specialWord == "equivalent"){
+                    int id1, id2;
+                    specialStream>>id1;
+                    specialStream>>id2;
+
+                    std::string counterexample;
+                    if(NFA::equivalent(cache.get(id1), cache.get(id2), counterexample))
+                        std::cout<<"Yes"<<std::endl;
+                    else
+                        std::cout<<"No, counterexample: \""<<counterexample<<"\""<<std::endl;
+                    std::cout<<std::endl;
+                }
+
+                //if the user input is "includes" - gets the two identifiers that the user inputed and checks if the first
+                //NFA recognizes every word of the second one; if not, prints a word that only the second one recognizes
+                if(specialWord == "includes"){
+                    int id1, id2;
+                    specialStream>>id1;
+                    specialStream>>id2;
+
+                    std::string counterexample;
+                    if(NFA::includes(cache.get(id1), cache.get(id2), counterexample))
+                        std::cout<<"Yes"<<std::endl;
+                    else
+                        std::cout<<"No, counterexample: \""<<counterexample<<"\""<<std::endl;
+                    std::cout<<std::endl;
+                }
+
                 //if the user input is "deterministic" - gets the identifier that the user inputed, finds the NFA with this
-                //identifier in the file and checks if it's deterministic, then prints the result
+                //identifier in the file and checks if it's deterministic, then prints the result and, if it isn't, the
+                //states and literals that have more than one transition
                 if(specialWord == "deterministic"){
                     int id1;
                     specialStream>>id1;
 
-                    NFA one;
-                    one.readFromFile(id1);
-                    if(one.isDeterministic())
+                    std::vector<std::pair<int, char> > conflicts;
+                    if(cache.get(id1).isDeterministic(conflicts)){
                         std::cout<<"Yes"<<std::endl;
-                    else
-                        std::cout<<"No"<<std::endl;
+                    }else{
+                        std::cout<<"No, conflicts:";
+                        for(size_t i = 0; i < conflicts.size(); i++)
+                            std::cout<<" ("<<conflicts[i].first<<", "<<conflicts[i].second<<")";
+                        std::cout<<std::endl;
+                    }
                 }
 
                 //if the user input is "empty" - gets the identifier that the user inputed, finds the NFA with this
-                //identifier in the file and checks if its language is empty, then prints the result
+                //identifier in the file and checks if its language is empty, then prints the result and, if it isn't,
+                //a shortest word of the language
                 if(specialWord == "empty"){
                     int id1;
                     specialStream>>id1;
 
-                    NFA one;
-                    one.readFromFile(id1);
-                    if(one.isEmptyLanguage())
+                    std::string witness;
+                    if(cache.get(id1).isEmptyLanguage(witness))
                         std::cout<<"Yes"<<std::endl;
                     else
-                        std::cout<<"No"<<std::endl;
+                        std::cout<<"No, shortest word: \""<<witness<<"\""<<std::endl;
+                }
+
+                //if the user input is "minimize" - gets the identifier that the user inputed, compiles the NFA with this
+                //identifier to DFA, minimizes it and prints the number of states before and after the minimization and the
+                //number of byte classes (columns of the DFA table)
+                if(specialWord == "minimize"){
+                    int id1;
+                    specialStream>>id1;
+
+                    DFA dfa;
+                    if(cache.get(id1).compileToDFA(dfa)){
+                        MinimizationStats stats = dfa.minimize();
+                        std::cout<<"DFA states: "<<stats.statesBefore<<" -> "<<stats.statesAfter<<std::endl;
+                        std::cout<<"Byte classes: "<<dfa.getAlphabetSize()<<std::endl;
+                    }else{
+                        std::cout<<"DFA is too big!"<<std::endl;
+                    }
+                }
+
+                //if the user input is "trim" - gets the identifier that the user inputed, removes the states of the NFA
+                //with this identifier that are unreachable or can't reach a final state, prints how many states and
+                //transitions were left and the trimmed NFA
+                if(specialWord == "trim"){
+                    int id1;
+                    specialStream>>id1;
+
+                    NFA one = cache.get(id1);
+                    one.setID(id1);
+                    printTrimStats(one.trim());
+                    one.print();
                 }
 
                 //if the user input is "recognize" - gets the identifier that the user inputed, finds the NFA with this
@@ -237,17 +401,140 @@ int main() {
                     int id;
                     specialStream>>id;
 
-                    NFA one;
-                    one.readFromFile(id);
-
-                    char word[10];
+                    std::string word;
                     specialStream>>word;
 
-                    if(one.recognise(word))
+                    if(cache.recognise(id, word.data(), word.size()))
                         std::cout<<"Yes"<<std::endl;
                     else
                         std::cout<<"No"<<std::endl;
                 }
+
+                //if the user input is "recognizeAll" - finds all the NFA from the file that recognize the word that the
+                //user inputed, with one pass over the word, and prints their identifiers; the merged set of the NFA is
+                //kept by the cache until the file changes
+                if(specialWord == "recognizeAll"){
+                    std::string word;
+                    specialStream>>word;
+
+                    const NFASet& set = cache.getSet(fileTemp);
+                    std::vector<int> accepted;
+                    set.match(word.data(), word.size(), accepted);
+                    std::cout<<"Recognized by "<<accepted.size()<<" of "<<set.size()<<" NFA:";
+                    for(size_t i = 0; i < accepted.size(); i++)
+                        std::cout<<" "<<accepted[i];
+                    std::cout<<std::endl<<std::endl;
+                }
+
+                //if the user input is "recognizeFile" - gets the identifier and the name of a newline-delimited word
+                //file that the user inputed, checks all the words of the file on all the cores and prints how many of
+                //them the NFA recognizes
+                if(specialWord == "recognizeFile"){
+                    int id;
+                    std::string wordsName;
+                    specialStream>>id>>wordsName;
+
+                    WordList words;
+                    if(!words.readFromFile(wordsName)){
+                        std::cout<<"Couldn't open file!"<<std::endl;
+                    }else{
+                        const DFA* dfa = cache.getDFA(id);
+                        BatchResult result = dfa != nullptr ? recognizeBatch(*dfa, words)
+                                                            : recognizeBatch(Simulator(cache.getIndex(id)), words);
+                        std::cout<<"Recognized "<<result.acceptedNum<<" of "<<result.wordsNum<<" words"<<std::endl;
+                    }
+                    std::cout<<std::endl;
+                }
+
+                //if the user input is "recognizeStream" - gets the identifier and the name of a file that the user
+                //inputed and checks if the NFA recognizes the whole content of the file as one word; the file is read
+                //in chunks, so it can be of any size, and every chunk is checked on all the cores
+                if(specialWord == "recognizeStream"){
+                    int id;
+                    std::string inputName;
+                    specialStream>>id>>inputName;
+
+                    std::ifstream input(inputName, std::ios::in | std::ios::binary);
+                    if(!input){
+                        std::cout<<"Couldn't open file!"<<std::endl;
+                    }else{
+                        //the simulator is built only if the NFA has no DFA
+                        const DFA* dfa = cache.getDFA(id);
+                        std::unique_ptr<Simulator> simulator;
+                        if(dfa == nullptr)
+                            simulator.reset(new Simulator(cache.getIndex(id)));
+                        StreamMatcher matcher = dfa != nullptr ? StreamMatcher(*dfa) : StreamMatcher(*simulator);
+
+                        std::vector<char> chunk(1 << 24);
+                        while(input && !matcher.isDead()){
+                            input.read(chunk.data(), chunk.size());
+                            matcher.feed(chunk.data(), size_t(input.gcount()));
+                        }
+
+                        if(matcher.finish())
+                            std::cout<<"Yes"<<std::endl;
+                        else
+                            std::cout<<"No"<<std::endl;
+                    }
+                    std::cout<<std::endl;
+                }
+
+                //if the user input is "search" - gets the identifier and the name of a file that the user inputed and
+                //prints the offsets of all the occurrences of words of the NFA in the file; the longest occurrences are
+                //printed unless the user inputs "shortest" after the file name
+                if(specialWord == "search"){
+                    int id;
+                    std::string inputName, kindName;
+                    specialStream>>id>>inputName>>kindName;
+
+                    std::vector<char> text;
+                    if(!readContent(inputName, text)){
+                        std::cout<<"Couldn't open file!"<<std::endl;
+                    }else{
+                        Searcher searcher(cache.get(id));
+                        if(!searcher.isCompiled()){
+                            std::cout<<"DFA is too big!"<<std::endl;
+                        }else{
+                            std::vector<Match> matches;
+                            searcher.findAll(text.data(), text.size(),
+                                             kindName == "shortest" ? LEFTMOST_SHORTEST : LEFTMOST_LONGEST, matches);
+                            for(size_t i = 0; i < matches.size(); i++)
+                                std::cout<<matches[i].start<<" "<<matches[i].end<<std::endl;
+                            std::cout<<"Found "<<matches.size()<<" occurrences"<<std::endl;
+                        }
+                    }
+                    std::cout<<std::endl;
+                }
+
+                //if the user input is "exportBinary" - writes all the NFAs from the file to a binary NFA file which name
+                //the user inputs
+                if(specialWord == "exportBinary"){
+                    std::string binaryName;
+                    specialStream>>binaryName;
+                    appendAttached(cache, fileTemp);
+                    fileTemp.flush();
+
+                    if(BinaryCatalog::convertTextToBinary("temp.txt", binaryName))
+                        std::cout<<"File exported!"<<std::endl;
+                    else
+                        std::cout<<"Couldn't export file!"<<std::endl;
+                    std::cout<<std::endl;
+                }
+
+                //if the user input is "importBinary" - adds all the NFAs from a binary NFA file which name the user inputs
+                //to the file; the binary file is attached to the session, so its automata are loaded by identifier
+                //straight from their records, and it's converted to text only when the file is saved or exported
+                if(specialWord == "importBinary"){
+                    std::string binaryName;
+                    specialStream>>binaryName;
+                    appendAttached(cache, fileTemp);
+
+                    if(cache.attach(binaryName))
+                        std::cout<<"File imported!"<<std::endl;
+                    else
+                        std::cout<<"Couldn't import file!"<<std::endl;
+                    std::cout<<std::endl;
+                }
             }
         }
 
@@ -266,10 +553,23 @@ int main() {
             std::cout<<"|| print <id>             ||    prints all NFA transitions              ||"<<std::endl;
             std::cout<<"|| empty <id>             ||    checks if NFA language is empty         ||"<<std::endl;
             std::cout<<"|| deterministic <id>     ||    checks if NFA is deterministic          ||"<<std::endl;
+            std::cout<<"|| minimize <id>          ||    minimal DFA size of NFA                 ||"<<std::endl;
+            std::cout<<"|| trim <id>              ||    removes useless states of NFA           ||"<<std::endl;
             std::cout<<"|| recognize <id> <word>  ||    checks if NFA recognizes word           ||"<<std::endl;
+            std::cout<<"|| recognizeAll <word>    ||    all NFA of the file that recognize word ||"<<std::endl;
+            std::cout<<"|| recognizeFile <id> <f> ||    counts words of <f> NFA recognizes      ||"<<std::endl;
+            std::cout<<"|| recognizeStream <id> <f>||   checks if NFA recognizes content of <f> ||"<<std::endl;
+            std::cout<<"|| search <id> <f> [shortest]|| offsets of words of NFA in <f>          ||"<<std::endl;
             std::cout<<"|| union <id1> <id2>      ||    union of two NFA                        ||"<<std::endl;
             std::cout<<"|| concat <id1> <id2>     ||    concatenate two NFA                     ||"<<std::endl;
             std::cout<<"|| positive <id>          ||    positive shell of NFA                   ||"<<std::endl;
+            std::cout<<"|| intersect <id1> <id2>  ||    intersection of two NFA                 ||"<<std::endl;
+            std::cout<<"|| difference <id1> <id2> ||    words of <id1> that aren't in <id2>     ||"<<std::endl;
+            std::cout<<"|| equivalent <id1> <id2> ||    checks if two NFA have the same language||"<<std::endl;
+            std::cout<<"|| includes <id1> <id2>   ||    checks if <id1> has all words of <id2>  ||"<<std::endl;
+            std::cout<<"|| recognizeDifference <id1> <id2> <word> ||  in <id1>, not in <id2>    ||"<<std::endl;
+            std::cout<<"|| exportBinary <file>    ||    writes all NFA to binary <file>         ||"<<std::endl;
+            std::cout<<"|| importBinary <file>    ||    adds all NFA from binary <file>         ||"<<std::endl;
             std::cout<<" //////////////////////////////////////////////////////////////////////// "<<std::endl;
             std::cout<<std::endl;
         }
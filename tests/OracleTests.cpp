@@ -0,0 +1,694 @@
+/**
+ * @file OracleTests.cpp
+ * @details Checks the engines, the language algebra, the search, the trimming and the binary files against a plain
+ * set-based simulation of the NFA on random automata. Every group is one test of the NFA_tests target; with no
+ * argument all the groups are run.
+ */
+
+#include<algorithm>
+#include<cstdio>
+#include<cstring>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<random>
+#include<set>
+#include<sstream>
+#include<string>
+#include<utility>
+#include<vector>
+#include"../NFA.h"
+#include"../AutomatonCache.h"
+#include"../Batch.h"
+#include"../BinaryCatalog.h"
+#include"../DFA.h"
+#include"../LazyDFA.h"
+#include"../MappedCatalog.h"
+#include"../NFAIndex.h"
+#include"../NFASet.h"
+#include"../ParallelDFA.h"
+#include"../Prefilter.h"
+#include"../Product.h"
+#include"../Search.h"
+#include"../ShiftAnd.h"
+#include"../Simulator.h"
+#include"../StreamMatcher.h"
+
+static int failures = 0;
+
+/**
+ * @details Reports a failed check.
+ * @param condition - the result of the check;
+ * @param what - description of the check;
+ */
+static void expect(bool condition, const std::string& what){
+    if(!condition){
+        if(failures < 20)
+            std::cout<<"FAILED: "<<what<<std::endl;
+        failures++;
+    }
+}
+
+/**
+ * @brief The oracle.
+ * @details Keeps the set of active state names and follows the ε-transitions until nothing changes. A state is final
+ * if it's final in the states array or if it's the initial state and the initial state is final.
+ *
+ * @param nfa - reference to an object of type NFA;
+ * @param word - the word;
+ * @return true if the NFA recognizes the word and false otherwise.
+ */
+static bool oracle(const NFA& nfa, const std::string& word){
+    const Transition* transitions = nfa.getTransitions();
+    int transitionsNum = nfa.getCurrentTransitionsNum();
+    auto close = [&](std::set<int>& set){
+        bool changed = true;
+        while(changed){
+            changed = false;
+            for(int i = 0; i < transitionsNum; i++){
+                if(transitions[i].literal == '^' && set.count(transitions[i].from) && !set.count(transitions[i].to)){
+                    set.insert(transitions[i].to);
+                    changed = true;
+                }
+            }
+        }
+    };
+
+    std::set<int> current;
+    current.insert(nfa.getInitialState().name);
+    close(current);
+    for(size_t k = 0; k < word.size(); k++){
+        std::set<int> next;
+        for(int i = 0; i < transitionsNum; i++){
+            if(transitions[i].literal == word[k] && current.count(transitions[i].from))
+                next.insert(transitions[i].to);
+        }
+        close(next);
+        current.swap(next);
+    }
+
+    if(nfa.getInitialState().isFinal && current.count(nfa.getInitialState().name))
+        return true;
+    for(int i = 0; i < nfa.getCurrentStatesNum(); i++){
+        if(nfa.getStates()[i].isFinal && current.count(nfa.getStates()[i].name))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @param maxLength - the maximum length of the words;
+ * @return all the words over {a, b} of length up to maxLength, shorter first.
+ */
+static std::vector<std::string> allWords(size_t maxLength){
+    std::vector<std::string> words(1, "");
+    for(size_t i = 0; i < words.size(); i++){
+        if(words[i].size() < maxLength){
+            words.push_back(words[i] + "a");
+            words.push_back(words[i] + "b");
+        }
+    }
+    return words;
+}
+
+/**
+ * @brief Random NFA over {a, b} with ε-transitions.
+ * @details Some transitions lead to states that are only in transitions and the initial state may be final only
+ * through the initial state flag.
+ *
+ * @param random - the random generator;
+ * @param maxStates - the maximum number of states;
+ * @return the NFA.
+ */
+static NFA randomNFA(std::mt19937& random, int maxStates){
+    NFA nfa;
+    int statesNum = 1 + int(random() % maxStates);
+    for(int i = 0; i < statesNum; i++)
+        nfa.addState(State(3 * i + 1, random() % 4 == 0));
+    nfa.setInitialState(State(1, random() % 6 == 0));
+    int transitionsNum = int(random() % (3 * statesNum + 2));
+    for(int i = 0; i < transitionsNum; i++)
+        nfa.addTransition(Transition(3 * int(random() % statesNum) + 1, 3 * int(random() % (statesNum + 1)) + 1,
+                                     "ab^"[random() % 3]));
+    return nfa;
+}
+
+/**
+ * @brief Random NFA in the form the union, concatenation and positive shell expect.
+ * @details The state names are first + 1, first + 2, ..., so NFA built with different first have no common states,
+ * the initial state is in the states array and no transition leads to it.
+ *
+ * @param random - the random generator;
+ * @param first - the state names start after it;
+ * @return the NFA.
+ */
+static NFA operandNFA(std::mt19937& random, int first){
+    NFA nfa;
+    int statesNum = 1 + int(random() % 5);
+    for(int i = 0; i < statesNum; i++)
+        nfa.addState(State(first + i + 1, random() % 3 == 0));
+    nfa.setInitialState(nfa.getStates()[0]);
+    int transitionsNum = int(random() % (2 * statesNum + 2));
+    for(int i = 0; i < transitionsNum; i++)
+        nfa.addTransition(Transition(first + int(random() % statesNum) + 1, first + int(random() % statesNum) + 1,
+                                     "ab^"[random() % 3]));
+
+    //removes the transitions to the initial state
+    NFA result(nullptr, statesNum, 0, nullptr, transitionsNum, 0);
+    result.setInitialState(nfa.getInitialState());
+    for(int i = 0; i < nfa.getCurrentStatesNum(); i++)
+        result.addState(nfa.getStates()[i]);
+    for(int i = 0; i < nfa.getCurrentTransitionsNum(); i++){
+        if(nfa.getTransitions()[i].to != first + 1)
+            result.addTransition(nfa.getTransitions()[i]);
+    }
+    return result;
+}
+
+/**
+ * @return true if the two NFA have the same initial state, states and transitions in the same order.
+ */
+static bool sameArrays(const NFA& one, const NFA& two){
+    if(one.getInitialState().name != two.getInitialState().name ||
+       one.getInitialState().isFinal != two.getInitialState().isFinal ||
+       one.getCurrentStatesNum() != two.getCurrentStatesNum() ||
+       one.getCurrentTransitionsNum() != two.getCurrentTransitionsNum())
+        return false;
+    for(int i = 0; i < one.getCurrentStatesNum(); i++){
+        if(one.getStates()[i].name != two.getStates()[i].name || one.getStates()[i].isFinal != two.getStates()[i].isFinal)
+            return false;
+    }
+    for(int i = 0; i < one.getCurrentTransitionsNum(); i++){
+        const Transition& first = one.getTransitions()[i];
+        const Transition& second = two.getTransitions()[i];
+        if(first.from != second.from || first.to != second.to || first.literal != second.literal)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @return the number of distinct sets of (from, to) pairs the 256 bytes are literals of - the coarsest number of
+ * byte classes.
+ */
+static uint32_t signaturesNum(const NFA& nfa){
+    std::vector<std::set<std::pair<int, int> > > pairs(256);
+    for(int i = 0; i < nfa.getCurrentTransitionsNum(); i++){
+        const Transition& transition = nfa.getTransitions()[i];
+        if(transition.literal != '^')
+            pairs[(unsigned char)transition.literal].insert(std::make_pair(transition.from, transition.to));
+    }
+    return uint32_t(std::set<std::set<std::pair<int, int> > >(pairs.begin(), pairs.end()).size());
+}
+
+/**
+ * @brief Recognition engines.
+ * @details Simulator, ShiftAnd, NFA::recognise, the DFA before and after minimization, LazyDFA with a tiny budget,
+ * StreamMatcher, the batch recognition and the parallel DFA run must all agree with the oracle.
+ */
+static void testEngines(){
+    std::mt19937 random(15);
+    std::vector<std::string> words = allWords(6);
+    WordList list;
+    for(size_t i = 0; i < words.size(); i++)
+        list.buffer += words[i] + "\n";
+    list.split();
+
+    for(int iteration = 0; iteration < 400; iteration++){
+        NFA nfa = randomNFA(random, iteration % 4 == 0 ? 90 : 8);
+        Simulator simulator(nfa);
+        ShiftAnd shiftAnd(nfa);
+        DFA dfa;
+        bool compiled = nfa.compileToDFA(dfa);
+        DFA minimal(dfa);
+        minimal.minimize();
+        LazyDFA lazy(nfa, 256);
+        NFA epsilonFree = nfa.removeEpsilon();
+
+        for(size_t i = 0; i < words.size(); i++){
+            const std::string& word = words[i];
+            bool expected = oracle(nfa, word);
+            expect(simulator.recognise(word.data(), word.size()) == expected, "Simulator " + word);
+            expect(nfa.recognise(word.c_str()) == expected, "NFA::recognise " + word);
+            if(shiftAnd.isSupported())
+                expect(shiftAnd.recognise(word.data(), word.size()) == expected, "ShiftAnd " + word);
+            if(compiled){
+                expect(dfa.recognise(word.data(), word.size()) == expected, "DFA " + word);
+                expect(minimal.recognise(word.data(), word.size()) == expected, "minimal DFA " + word);
+            }
+            expect(lazy.recognise(word.data(), word.size()) == expected, "LazyDFA " + word);
+            expect(oracle(epsilonFree, word) == expected, "removeEpsilon " + word);
+
+            StreamMatcher matcher(simulator);
+            matcher.feed(word.data(), word.size() / 2);
+            matcher.feed(word.data() + word.size() / 2, word.size() - word.size() / 2);
+            expect(matcher.finish() == expected, "StreamMatcher " + word);
+        }
+
+        expect(simulator.getClasses().count == signaturesNum(nfa), "number of byte classes");
+        if(compiled)
+            expect(dfa.getAlphabetSize() == signaturesNum(nfa), "DFA row length");
+
+        BatchResult bySimulator = recognizeBatch(simulator, list, 2);
+        for(size_t i = 0; i < words.size(); i++)
+            expect(bySimulator.isAccepted(i) == oracle(nfa, words[i]), "batch simulator " + words[i]);
+        if(compiled){
+            BatchResult byDFA = recognizeBatch(dfa, list, 2);
+            for(size_t i = 0; i < words.size(); i++)
+                expect(byDFA.isAccepted(i) == oracle(nfa, words[i]), "batch DFA " + words[i]);
+        }
+    }
+
+    //one edge on [a-z] is one class next to the class of the other bytes, repeated transitions don't split it and an
+    //edge on x alone splits x off
+    NFA range;
+    range.addState(State(1, false));
+    range.addState(State(2, true));
+    range.setInitialState(State(1, false));
+    for(char c = 'a'; c <= 'z'; c++)
+        range.addTransition(Transition(1, 2, c));
+    range.addTransition(Transition(1, 2, 'q'));
+    DFA rangeDFA;
+    expect(Simulator(range).getClasses().count == 2 && range.compileToDFA(rangeDFA) &&
+           rangeDFA.getAlphabetSize() == 2, "[a-z] is one byte class");
+    ByteClasses classes = Simulator(range).getClasses();
+    expect(classes.classOf['a'] == classes.classOf['z'] && classes.classOf['a'] != classes.classOf['0'],
+           "classes of the [a-z] bytes");
+    range.addTransition(Transition(2, 2, 'x'));
+    expect(Simulator(range).getClasses().count == 3, "x is split off [a-z]");
+
+    //the parallel run only splits inputs longer than PARALLEL_MIN_LENGTH
+    for(int iteration = 0; iteration < 3; iteration++){
+        NFA nfa = randomNFA(random, 6);
+        DFA dfa;
+        if(!nfa.compileToDFA(dfa))
+            continue;
+        std::string text(2 * PARALLEL_MIN_LENGTH + 17, 'a');
+        for(size_t i = 0; i < text.size(); i++)
+            text[i] = "ab"[random() % 2];
+        uint32_t state = dfa.getStart();
+        for(size_t i = 0; i < text.size(); i++)
+            state = dfa.next(state, (unsigned char)text[i]);
+        expect(runParallel(dfa, dfa.getStart(), text.data(), text.size(), 4) == state, "runParallel");
+    }
+}
+
+/**
+ * @brief The language algebra.
+ * @details Intersection, difference, the product matcher, equivalence, inclusion, emptiness with its shortest word,
+ * the determinism conflicts, the reverse NFA and NFASet are compared with the oracle on all the short words.
+ */
+static void testAlgebra(){
+    std::mt19937 random(21);
+    std::vector<std::string> words = allWords(6);
+
+    for(int iteration = 0; iteration < 300; iteration++){
+        NFA one = randomNFA(random, 6), two = randomNFA(random, 6);
+        NFA intersection = NFA::makeIntersect(one, two), difference = NFA::makeDifference(one, two);
+        ProductMatcher matcher(one, two, DIFFERENCE);
+        NFA reversed = one.reversed();
+        bool sameOnWords = true, twoInOne = true;
+
+        for(size_t i = 0; i < words.size(); i++){
+            const std::string& word = words[i];
+            bool first = oracle(one, word), second = oracle(two, word);
+            expect(oracle(intersection, word) == (first && second), "intersection " + word);
+            expect(oracle(difference, word) == (first && !second), "difference " + word);
+            expect(matcher.recognise(word.data(), word.size()) == (first && !second), "ProductMatcher " + word);
+            expect(oracle(reversed, std::string(word.rbegin(), word.rend())) == first, "reversed " + word);
+            sameOnWords = sameOnWords && first == second;
+            twoInOne = twoInOne && (!second || first);
+        }
+
+        std::string counterexample;
+        if(NFA::equivalent(one, two, counterexample))
+            expect(sameOnWords, "equivalent without a counterexample");
+        else
+            expect(oracle(one, counterexample) != oracle(two, counterexample), "equivalence counterexample");
+        expect(NFA::equivalent(one, one.removeEpsilon(), counterexample), "equivalent to its ε-free NFA");
+
+        if(NFA::includes(one, two, counterexample))
+            expect(twoInOne, "includes without a counterexample");
+        else
+            expect(oracle(two, counterexample) && !oracle(one, counterexample), "inclusion counterexample");
+
+        //the shortest word of a language is shorter than the number of states
+        std::string witness;
+        if(one.isEmptyLanguage(witness)){
+            for(size_t i = 0; i < words.size(); i++)
+                expect(!oracle(one, words[i]), "empty language accepts " + words[i]);
+        }else{
+            expect(oracle(one, witness), "witness " + witness);
+            for(size_t i = 0; i < words.size() && words[i].size() < witness.size(); i++)
+                expect(!oracle(one, words[i]), "shorter word than the witness " + words[i]);
+        }
+
+        std::set<std::pair<int, char> > expected;
+        std::set<std::pair<std::pair<int, char>, int> > targets;
+        for(int i = 0; i < one.getCurrentTransitionsNum(); i++){
+            const Transition& transition = one.getTransitions()[i];
+            std::pair<int, char> key(transition.from, transition.literal);
+            if(transition.literal == '^')
+                expected.insert(key);
+            targets.insert(std::make_pair(key, transition.to));
+        }
+        for(std::set<std::pair<std::pair<int, char>, int> >::iterator it = targets.begin(); it != targets.end(); ++it){
+            std::set<std::pair<std::pair<int, char>, int> >::iterator next = it;
+            if(++next != targets.end() && next->first == it->first)
+                expected.insert(it->first);
+        }
+        std::vector<std::pair<int, char> > conflicts;
+        bool deterministic = one.isDeterministic(conflicts);
+        expect(deterministic == expected.empty(), "isDeterministic");
+        expect(std::set<std::pair<int, char> >(conflicts.begin(), conflicts.end()) == expected &&
+               conflicts.size() == expected.size(), "determinism conflicts");
+    }
+
+    for(int iteration = 0; iteration < 50; iteration++){
+        std::vector<NFA> nfas;
+        for(int i = 0; i < 5; i++)
+            nfas.push_back(randomNFA(random, 6));
+        std::vector<const NFA*> pointers;
+        for(size_t i = 0; i < nfas.size(); i++)
+            pointers.push_back(&nfas[i]);
+        NFASet set(pointers);
+        for(size_t i = 0; i < words.size(); i++){
+            std::vector<int> accepted, expected;
+            set.match(words[i].data(), words[i].size(), accepted);
+            for(size_t j = 0; j < nfas.size(); j++){
+                if(oracle(nfas[j], words[i]))
+                    expected.push_back(nfas[j].getID());
+            }
+            std::sort(accepted.begin(), accepted.end());
+            expect(accepted == expected, "NFASet " + words[i]);
+        }
+    }
+}
+
+/**
+ * @brief The unanchored search.
+ * @details The occurrences are compared with the leftmost-longest and leftmost-shortest occurrences found by trying
+ * every start and end with the oracle.
+ */
+static void testSearch(){
+    std::mt19937 random(18);
+    for(int iteration = 0; iteration < 150; iteration++){
+        NFA nfa = randomNFA(random, 5);
+        Searcher searcher(nfa);
+        if(!searcher.isCompiled())
+            continue;
+        std::string text(random() % 40, 'a');
+        for(size_t i = 0; i < text.size(); i++)
+            text[i] = "abc"[random() % 3];
+
+        for(int kind = 0; kind < 2; kind++){
+            std::vector<Match> expected;
+            size_t position = 0;
+            while(position <= text.size()){
+                size_t start = position, end = 0;
+                bool found = false;
+                for(; start <= text.size() && !found; start++){
+                    for(size_t last = start; last <= text.size(); last++){
+                        if(oracle(nfa, text.substr(start, last - start))){
+                            end = last;
+                            found = true;
+                            if(kind == LEFTMOST_SHORTEST)
+                                break;
+                        }
+                    }
+                }
+                if(!found)
+                    break;
+                start--;
+                Match match;
+                match.start = start;
+                match.end = end;
+                expected.push_back(match);
+                position = end > start ? end : start + 1;
+            }
+
+            std::vector<Match> matches;
+            searcher.findAll(text.data(), text.size(), MatchKind(kind), matches);
+            bool same = matches.size() == expected.size();
+            for(size_t i = 0; same && i < matches.size(); i++)
+                same = matches[i].start == expected[i].start && matches[i].end == expected[i].end;
+            expect(same, "findAll in " + text);
+        }
+    }
+
+    //every a is a candidate of the prefilter of aa*b, but only the one before the b starts an occurrence, so a
+    //forward run from every candidate would be quadratic
+    NFA nfa;
+    nfa.addState(State(1, false));
+    nfa.addState(State(2, false));
+    nfa.addState(State(3, true));
+    nfa.setInitialState(State(1, false));
+    nfa.addTransition(Transition(1, 2, 'a'));
+    nfa.addTransition(Transition(2, 2, 'a'));
+    nfa.addTransition(Transition(2, 3, 'b'));
+    Searcher searcher(nfa);
+    expect(Prefilter(nfa).isUsable() && searcher.isCompiled(), "prefilter of aa*b");
+    std::string text(size_t(1) << 21, 'a');
+    std::vector<Match> matches;
+    searcher.findAll(text.data(), text.size(), LEFTMOST_LONGEST, matches);
+    expect(matches.empty(), "aa*b in a text of a");
+    text += "b";
+    for(int kind = 0; kind < 2; kind++){
+        searcher.findAll(text.data(), text.size(), MatchKind(kind), matches);
+        expect(matches.size() == 1 && matches[0].start == 0 && matches[0].end == text.size(), "aa*b before b");
+    }
+    text[text.size() / 2] = 'c';
+    searcher.findAll(text.data(), text.size(), LEFTMOST_LONGEST, matches);
+    expect(matches.size() == 1 && matches[0].start == text.size() / 2 + 1, "aa*b after c");
+}
+
+/**
+ * @brief The combinators and the trimming.
+ * @details The union, concatenation and positive shell of NFA in the form they expect are compared with the oracle,
+ * trim() must keep the language and leave only useful states and the combinators must report their trimming.
+ */
+static void testTrim(){
+    std::mt19937 random(25);
+    std::vector<std::string> words = allWords(6);
+
+    for(int iteration = 0; iteration < 400; iteration++){
+        NFA nfa = randomNFA(random, 7);
+        NFA trimmed(nfa);
+        TrimStats stats = trimmed.trim();
+        expect(stats.statesBefore == nfa.getCurrentStatesNum() && stats.statesAfter == trimmed.getCurrentStatesNum() &&
+               stats.transitionsBefore == nfa.getCurrentTransitionsNum() &&
+               stats.transitionsAfter == trimmed.getCurrentTransitionsNum(), "trim statistics");
+        expect(trimmed.getTrimStats().statesAfter == stats.statesAfter, "getTrimStats");
+        for(size_t i = 0; i < words.size(); i++)
+            expect(oracle(trimmed, words[i]) == oracle(nfa, words[i]), "trim keeps " + words[i]);
+
+        //every state left, except the initial one, is reachable and co-reachable
+        NFAIndex index(trimmed);
+        std::vector<bool> reachable(index.getStatesNum(), false), coReachable(index.getStatesNum(), false);
+        reachable[index.getStart()] = true;
+        for(int q = 0; q < index.getStatesNum(); q++)
+            coReachable[q] = index.isFinal(q);
+        for(bool changed = true; changed;){
+            changed = false;
+            for(int q = 0; q < index.getStatesNum(); q++){
+                for(int i = index.begin(q); i < index.end(q); i++){
+                    int to = index.targetAt(i);
+                    if(reachable[q] && !reachable[to])
+                        reachable[to] = changed = true;
+                    if(coReachable[to] && !coReachable[q])
+                        coReachable[q] = changed = true;
+                }
+            }
+        }
+        bool useful = true;
+        for(int i = 0; i < trimmed.getCurrentStatesNum(); i++){
+            int q = index.indexOf(trimmed.getStates()[i].name);
+            if(q != index.getStart() && !(reachable[q] && coReachable[q]))
+                useful = false;
+        }
+        expect(useful, "trim leaves only useful states");
+        TrimStats again = trimmed.trim();
+        expect(again.statesAfter == again.statesBefore && again.transitionsAfter == again.transitionsBefore,
+               "trim is idempotent");
+    }
+
+    for(int iteration = 0; iteration < 300; iteration++){
+        NFA one = operandNFA(random, 10), two = operandNFA(random, 20);
+        NFA unionNFA = NFA::makeUnion(one, two);
+        NFA concat = NFA::makeConcat(one, two), movedConcat = NFA::makeConcat(NFA(one), two);
+        NFA positive = NFA::makePositive(one), movedPositive = NFA::makePositive(NFA(one));
+        expect(unionNFA.getTrimStats().statesAfter == unionNFA.getCurrentStatesNum() &&
+               concat.getTrimStats().transitionsAfter == concat.getCurrentTransitionsNum() &&
+               positive.getTrimStats().statesAfter == positive.getCurrentStatesNum(), "combinators report trimming");
+
+        for(size_t i = 0; i < words.size(); i++){
+            const std::string& word = words[i];
+            expect(oracle(unionNFA, word) == (oracle(one, word) || oracle(two, word)), "union " + word);
+
+            bool inConcat = false;
+            for(size_t k = 0; k <= word.size(); k++)
+                inConcat = inConcat || (oracle(one, word.substr(0, k)) && oracle(two, word.substr(k)));
+            expect(oracle(concat, word) == inConcat, "concat " + word);
+            expect(oracle(movedConcat, word) == inConcat, "concat of rvalue " + word);
+
+            //reached[k] - the prefix of length k is a concatenation of nonempty words of one
+            std::vector<bool> reached(word.size() + 1, false);
+            reached[0] = true;
+            for(size_t k = 1; k <= word.size(); k++){
+                for(size_t j = 0; j < k && !reached[k]; j++)
+                    reached[k] = reached[j] && oracle(one, word.substr(j, k - j));
+            }
+            bool inPositive = word.empty() ? oracle(one, word) : reached[word.size()];
+            expect(oracle(positive, word) == inPositive, "positive " + word);
+            expect(oracle(movedPositive, word) == inPositive, "positive of rvalue " + word);
+        }
+    }
+
+    //the combinators of rvalues return new NFA, so they don't share the identifier of the moved NFA
+    NFA first = operandNFA(random, 10), second = operandNFA(random, 20);
+    int firstID = first.getID();
+    NFA concat = NFA::makeConcat(std::move(first), second);
+    NFA positive = NFA::makePositive(std::move(second));
+    expect(concat.getID() != firstID && concat.getID() != first.getID() && positive.getID() != second.getID() &&
+           positive.getID() != concat.getID(), "rvalue combinators get new identifiers");
+}
+
+/**
+ * @brief The binary NFA files.
+ * @details Automata written to a binary file must come back unchanged through BinaryCatalog and MappedCatalog, and
+ * the session cache must recognize the same words from the attached file.
+ */
+static void testCatalog(){
+    std::mt19937 random(7);
+    std::vector<std::string> words = allWords(5);
+    std::vector<NFA> nfas;
+    for(int i = 0; i < 40; i++){
+        nfas.push_back(randomNFA(random, 10));
+        nfas.back().setID(1000 - 7 * i);
+    }
+    const std::string name = "oracle_tests.bin";
+    expect(BinaryCatalog::write(name, nfas), "BinaryCatalog::write");
+
+    BinaryCatalog catalog;
+    MappedCatalog mapped;
+    AutomatonCache cache;
+    expect(catalog.open(name) && mapped.open(name) && cache.attach(name), "open binary file");
+    expect(catalog.getAutomataNum() == int(nfas.size()) && mapped.getAutomataNum() == int(nfas.size()) &&
+           cache.getAttachedNum() == int(nfas.size()), "number of automata");
+
+    for(size_t i = 0; i < nfas.size(); i++){
+        int id = nfas[i].getID();
+        NFA loaded;
+        expect(catalog.load(id, loaded) && sameArrays(loaded, nfas[i]), "BinaryCatalog::load");
+
+        NFAView view;
+        expect(mapped.find(id, view) && sameArrays(view.toNFA(), nfas[i]), "MappedCatalog::find");
+        for(size_t j = 0; j < words.size(); j++){
+            bool expected = oracle(nfas[i], words[j]);
+            expect(view.recognise(words[j].data(), words[j].size()) == expected, "NFAView " + words[j]);
+            expect(cache.recognise(id, words[j].data(), words[j].size()) == expected, "cache " + words[j]);
+        }
+        expect(sameArrays(cache.get(id), nfas[i]), "cache NFA");
+    }
+    NFA missing;
+    expect(!catalog.load(12345, missing), "missing identifier");
+
+    //the merged set is built once and kept until the attached file changes
+    std::stringstream noText;
+    const NFASet& set = cache.getSet(noText);
+    expect(&cache.getSet(noText) == &set && set.size() == nfas.size(), "the set is kept by the cache");
+    for(size_t j = 0; j < words.size(); j++){
+        std::vector<int> accepted, expected;
+        set.match(words[j].data(), words[j].size(), accepted);
+        for(size_t i = 0; i < nfas.size(); i++){
+            if(oracle(nfas[i], words[j]))
+                expected.push_back(nfas[i].getID());
+        }
+        std::sort(accepted.begin(), accepted.end());
+        std::sort(expected.begin(), expected.end());
+        expect(accepted == expected, "cached set " + words[j]);
+    }
+    std::vector<NFA> fewer(nfas.begin(), nfas.begin() + 3);
+    const std::string fewerName = "oracle_tests_fewer.bin";
+    expect(BinaryCatalog::write(fewerName, fewer) && cache.attach(fewerName) && cache.getSet(noText).size() == 3,
+           "the set is rebuilt for the new attached file");
+    std::remove(fewerName.c_str());
+
+    cache.detach();
+    mapped.close();
+    catalog.close();
+
+    //corrupt counts are rejected without allocating for them
+    std::string bytes;
+    {
+        std::ifstream file(name, std::ios::in | std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    const std::string corruptName = "oracle_tests_corrupt.bin";
+    auto writeBytes = [&](const std::string& content){
+        std::ofstream file(corruptName, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size());
+    };
+
+    BinaryFileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    BinaryIndexEntry first;
+    std::memcpy(&first, bytes.data() + sizeof(header), sizeof(first));
+
+    std::string corrupt(bytes);
+    header.automataNum = 0xFFFFFFFFu;
+    std::memcpy(&corrupt[0], &header, sizeof(header));
+    writeBytes(corrupt);
+    expect(!catalog.open(corruptName) && !mapped.open(corruptName), "index bigger than the file");
+
+    corrupt = bytes;
+    BinaryRecordHeader record;
+    std::memcpy(&record, bytes.data() + first.offset, sizeof(record));
+    record.statesNum = 0x7FFFFFFFu;
+    record.transitionsNum = 0x7FFFFFFFu;
+    std::memcpy(&corrupt[first.offset], &record, sizeof(record));
+    writeBytes(corrupt);
+    NFA corruptNFA;
+    expect(catalog.open(corruptName) && !catalog.load(first.id, corruptNFA), "record bigger than the file");
+
+    writeBytes(bytes.substr(0, bytes.size() / 2));
+    int loadedNum = 0;
+    if(catalog.open(corruptName)){
+        for(size_t i = 0; i < nfas.size(); i++){
+            NFA loaded;
+            loadedNum += catalog.load(nfas[i].getID(), loaded) ? 1 : 0;
+        }
+    }
+    expect(loadedNum < int(nfas.size()), "truncated file");
+
+    catalog.close();
+    std::remove(corruptName.c_str());
+    std::remove(name.c_str());
+}
+
+/**
+ * @details Runs the test group given as argument, or all the groups.
+ * @return 0 if all the checks passed and 1 otherwise.
+ */
+int main(int argc, char** argv){
+    struct Group{
+        const char* name;
+        void (*run)();
+    };
+    const Group groups[] = {{"engines", testEngines}, {"algebra", testAlgebra}, {"search", testSearch},
+                            {"trim", testTrim}, {"catalog", testCatalog}};
+
+    bool found = false;
+    for(size_t i = 0; i < sizeof(groups) / sizeof(groups[0]); i++){
+        if(argc < 2 || strcmp(argv[1], groups[i].name) == 0){
+            found = true;
+            groups[i].run();
+            std::cout<<groups[i].name<<": "<<(failures == 0 ? "ok" : "failed")<<std::endl;
+        }
+    }
+    if(!found){
+        std::cout<<"Unknown test group "<<argv[1]<<std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}